@@ -6,6 +6,10 @@
 
 #include "platform/Define.h"
 
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
 using namespace std;
 
 namespace MMAP
@@ -42,6 +46,88 @@ namespace MMAP
 
         return LISTFILE_OK;
     }
+
+    class Mutex
+    {
+        public:
+        #ifdef WIN32
+            Mutex() { InitializeCriticalSection(&m_mutex); }
+            ~Mutex() { DeleteCriticalSection(&m_mutex); }
+            void acquire() { EnterCriticalSection(&m_mutex); }
+            void release() { LeaveCriticalSection(&m_mutex); }
+        #else
+            Mutex() { pthread_mutex_init(&m_mutex, 0); }
+            ~Mutex() { pthread_mutex_destroy(&m_mutex); }
+            void acquire() { pthread_mutex_lock(&m_mutex); }
+            void release() { pthread_mutex_unlock(&m_mutex); }
+        #endif
+
+        private:
+            Mutex(const Mutex&);
+            Mutex& operator=(const Mutex&);
+
+        #ifdef WIN32
+            CRITICAL_SECTION m_mutex;
+        #else
+            pthread_mutex_t m_mutex;
+        #endif
+    };
+
+    class Guard
+    {
+        public:
+            Guard(Mutex &mutex) : m_mutex(mutex) { m_mutex.acquire(); }
+            ~Guard() { m_mutex.release(); }
+
+        private:
+            Mutex &m_mutex;
+    };
+
+    // minimal worker thread, derived classes implement run()
+    class Thread
+    {
+        public:
+            Thread() : m_started(false) {}
+            virtual ~Thread() {}
+
+            bool start()
+            {
+            #ifdef WIN32
+                m_handle = CreateThread(NULL, 0, threadProc, this, 0, NULL);
+                m_started = m_handle != NULL;
+            #else
+                m_started = pthread_create(&m_handle, NULL, threadProc, this) == 0;
+            #endif
+                return m_started;
+            }
+
+            void wait()
+            {
+                if(!m_started)
+                    return;
+
+            #ifdef WIN32
+                WaitForSingleObject(m_handle, INFINITE);
+                CloseHandle(m_handle);
+            #else
+                pthread_join(m_handle, NULL);
+            #endif
+                m_started = false;
+            }
+
+        protected:
+            virtual void run() = 0;
+
+        private:
+        #ifdef WIN32
+            static DWORD WINAPI threadProc(LPVOID arg) { ((Thread*)arg)->run(); return 0; }
+            HANDLE m_handle;
+        #else
+            static void* threadProc(void* arg) { ((Thread*)arg)->run(); return NULL; }
+            pthread_t m_handle;
+        #endif
+            bool m_started;
+    };
 }
 
 #endif
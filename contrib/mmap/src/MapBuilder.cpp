@@ -15,16 +15,30 @@ using namespace std;
 
 namespace MMAP
 {
+    class TileBuildWorker : public Thread
+    {
+        public:
+            TileBuildWorker(MapBuilder* builder, TileBuildContext* ctx) : m_builder(builder), m_ctx(ctx) {}
+
+        protected:
+            void run() { m_builder->processTileQueue(*m_ctx); }
+
+        private:
+            MapBuilder* m_builder;
+            TileBuildContext* m_ctx;
+    };
+
     MapBuilder::MapBuilder(float maxWalkableAngle,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
                            bool hiResHeightmaps, bool shredHeightmaps,
-                           bool debugOutput) :
+                           bool debugOutput, int threads) :
                            m_maxWalkableAngle  (maxWalkableAngle),
                            m_skipContinents    (skipContinents),
                            m_skipJunkMaps      (skipJunkMaps),
                            m_skipBattlegrounds (skipBattlegrounds),
                            m_debugOutput       (debugOutput),
-                           m_completeLists     (false)
+                           m_completeLists     (false),
+                           m_threads           (threads > 0 ? threads : 1)
     {
         m_vmapManager = new VMapManager2();
         m_tileBuilder = new TileBuilder(m_maxWalkableAngle, hiResHeightmaps, shredHeightmaps, m_vmapManager);
@@ -179,9 +193,9 @@ namespace MMAP
         if(!m_completeLists)
             getMapAndTileList(mapID);
 
-        set<uint32> tiles;
-        if(m_tiles.find(mapID) != m_tiles.end())
-            tiles = *m_tiles[mapID];
+        static const set<uint32> noTiles;
+        TileList::const_iterator tileItr = m_tiles.find(mapID);
+        const set<uint32> &tiles = tileItr != m_tiles.end() ? *tileItr->second : noTiles;
 
         loadVMap(mapID);
 
@@ -189,7 +203,7 @@ namespace MMAP
         int* tris;
         int count;
         uint32 i, tileX, tileY, vertCount = 0, triCount = 0;
-        for(set<uint32>::iterator it = tiles.begin(); it != tiles.end(); ++it)
+        for(set<uint32>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
         {
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
@@ -207,8 +221,8 @@ namespace MMAP
         uint32 j;
         for(i = 0; i < m_modelVertices.size(); ++i)
         {
-            vector<float> verts = *m_modelVertices[i];
-            vector<int> tris = *m_modelTriangles[i];
+            const vector<float> &verts = *m_modelVertices[i];
+            const vector<int> &tris = *m_modelTriangles[i];
 
             count = m_vertices.size() / 3;
 
@@ -237,12 +251,12 @@ namespace MMAP
         m_vmapManager->loadMap("vmaps", mapID, 64, 64);
         cout.clear(cout.goodbit);
 
-        set<uint32> tiles;
-        if(m_tiles.find(mapID) != m_tiles.end())
-            tiles = *m_tiles[mapID];
+        static const set<uint32> noTiles;
+        TileList::const_iterator tileItr = m_tiles.find(mapID);
+        const set<uint32> &tiles = tileItr != m_tiles.end() ? *tileItr->second : noTiles;
 
         uint32 tileX, tileY;
-        for(set<uint32>::iterator it = tiles.begin(); it != tiles.end(); ++it)
+        for(set<uint32>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
         {
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
@@ -268,7 +282,7 @@ namespace MMAP
         uint32 i;
         for(i = 0; i < count; ++i)
         {
-            ModelInstance instance = models[i];
+            ModelInstance &instance = models[i];
 
             vector<float>* modelVertices = new vector<float>;
             vector<int>* modelTriangles = new vector<int>;
@@ -278,8 +292,7 @@ namespace MMAP
             if(!worldModel)
                 continue;
 
-            vector<GroupModel> groupModels;
-            worldModel->getGroupModels(groupModels);
+            const vector<GroupModel> &groupModels = worldModel->getGroupModels();
 
             // all M2s need to have triangle indices reversed
             bool isM2 = instance.name.find(".m2") != instance.name.npos || instance.name.find(".M2") != instance.name.npos;
@@ -294,20 +307,16 @@ namespace MMAP
             //float heightOffset = TileBuilder::readHeightOffset(mapID, uint32(ceil(32-position.x/GRID_SIZE)), uint32(ceil(32-position.y/GRID_SIZE)));
             //position.z += heightOffset*2.f;
 
-            for(vector<GroupModel>::iterator it = groupModels.begin(); it != groupModels.end(); ++it)
+            for(vector<GroupModel>::const_iterator it = groupModels.begin(); it != groupModels.end(); ++it)
             {
-                vector<Vector3> tempVertices;
                 vector<Vector3> transformedVertices;
-                vector<MeshTriangle> tempTriangles;
-
-                (*it).getMeshData(tempVertices, tempTriangles);
 
-                transform(tempVertices, transformedVertices, scale, rotation, position);
+                transform((*it).getVertices(), transformedVertices, scale, rotation, position);
 
                 int offset = modelVertices->size() / 3;
 
                 copyVertices(transformedVertices, (*modelVertices));
-                copyIndices(tempTriangles, (*modelTriangles), offset, isM2);
+                copyIndices((*it).getTriangles(), (*modelTriangles), offset, isM2);
             }
 
             m_modelVertices.push_back(modelVertices);
@@ -321,12 +330,12 @@ namespace MMAP
     {
         printf("Unloading vmap...                       \r");
 
-        set<uint32> tiles;
-        if(m_tiles.find(mapID) != m_tiles.end())
-            tiles = *m_tiles[mapID];
+        static const set<uint32> noTiles;
+        TileList::const_iterator tileItr = m_tiles.find(mapID);
+        const set<uint32> &tiles = tileItr != m_tiles.end() ? *tileItr->second : noTiles;
 
         uint32 tileX, tileY;
-        for(set<uint32>::iterator it = tiles.begin(); it != tiles.end(); ++it)
+        for(set<uint32>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
         {
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
@@ -340,9 +349,10 @@ namespace MMAP
         cout.clear(cout.goodbit);
     }
 
-    inline void MapBuilder::transform(vector<Vector3> source, vector<Vector3> &transformedVertices, float scale, G3D::Matrix3 rotation, Vector3 position)
+    inline void MapBuilder::transform(const vector<Vector3> &source, vector<Vector3> &transformedVertices, float scale, const G3D::Matrix3 &rotation, const Vector3 &position)
     {
-        for(vector<Vector3>::iterator it = source.begin(); it != source.end(); ++it)
+        transformedVertices.reserve(transformedVertices.size() + source.size());
+        for(vector<Vector3>::const_iterator it = source.begin(); it != source.end(); ++it)
         {
             // apply tranform, then mirror along the horizontal axes
             Vector3 v((*it) * rotation * scale + position);
@@ -352,9 +362,10 @@ namespace MMAP
         }
     }
 
-    inline void MapBuilder::copyVertices(vector<Vector3> source, vector<float> &dest)
+    inline void MapBuilder::copyVertices(const vector<Vector3> &source, vector<float> &dest)
     {
-        for(vector<Vector3>::iterator it = source.begin(); it != source.end(); ++it)
+        dest.reserve(dest.size() + source.size()*3);
+        for(vector<Vector3>::const_iterator it = source.begin(); it != source.end(); ++it)
         {
             dest.push_back((*it).y);
             dest.push_back((*it).z);
@@ -362,12 +373,13 @@ namespace MMAP
         }
     }
 
-    inline void MapBuilder::copyIndices(vector<MeshTriangle> source, vector<int> &dest, int offset, bool flip)
+    inline void MapBuilder::copyIndices(const vector<MeshTriangle> &source, vector<int> &dest, int offset, bool flip)
     {
+        dest.reserve(dest.size() + source.size()*3);
         // evaluate flip once, makes faster code (but larger)
         if(flip)
         {
-            for(vector<MeshTriangle>::iterator it = source.begin(); it != source.end(); ++it)
+            for(vector<MeshTriangle>::const_iterator it = source.begin(); it != source.end(); ++it)
             {
                 dest.push_back((*it).idx2+offset);
                 dest.push_back((*it).idx1+offset);
@@ -376,7 +388,7 @@ namespace MMAP
         }
         else
         {
-            for(vector<MeshTriangle>::iterator it = source.begin(); it != source.end(); ++it)
+            for(vector<MeshTriangle>::const_iterator it = source.begin(); it != source.end(); ++it)
             {
                 dest.push_back((*it).idx0+offset);
                 dest.push_back((*it).idx1+offset);
@@ -392,9 +404,6 @@ namespace MMAP
         float agentRadius = .55f;
         float agentMaxClimb = 1.65f;
 
-        IntermediateValues iv;
-        initIntermediateValues(iv);
-
         char fileName[25];
         FILE* file = 0;
 
@@ -459,13 +468,16 @@ namespace MMAP
         navMeshParams.maxPolys = maxPolysPerTile;
         navMeshParams.maxNodes = 2048;
 
+        // each worker creates its own navMesh from these params, check them once here
         dtNavMesh* navMesh = new dtNavMesh;
         printf("Creating navMesh...                     \r");
         if(!navMesh->init(&navMeshParams))
         {
             printf("Failed creating navmesh!                \n");
+            delete navMesh;
             return;
         }
+        delete navMesh;
 
         sprintf(fileName, "mmaps\\%03u.mmap", mapID);
         if(!(file = fopen(fileName, "wb")))
@@ -477,7 +489,6 @@ namespace MMAP
         // now that we know navMesh params are valid, we can write them to file
         fwrite(&navMeshParams, sizeof(dtNavMeshParams), 1, file);
 
-        int tileX, tileY;
         float yMin = snapToGrid(bmin[0]);
         float xMin = snapToGrid(bmin[2]);
 
@@ -488,291 +499,376 @@ namespace MMAP
         if(!rcCreateChunkyTriMesh(verts, tris, triCount, 256, chunkyMesh))
         {
             printf("Failed creating ChunkyTriMesh!          \n");
+            delete chunkyMesh;
             return;
         }
 
-        char tileString[10]; // "[xx,yy]: "
+        TileBuildContext ctx;
+        ctx.mapID = mapID;
+        ctx.config = config;
+        ctx.navMeshParams = navMeshParams;
+        ctx.agentHeight = agentHeight;
+        ctx.agentRadius = agentRadius;
+        ctx.agentMaxClimb = agentMaxClimb;
+        ctx.yMin = yMin;
+        ctx.xMin = xMin;
+        ctx.verts = verts;
+        ctx.vertCount = vertCount;
+        ctx.tris = tris;
+        ctx.chunkyMesh = chunkyMesh;
+        ctx.nextTile = 0;
 
         for(int y = 0; y < yTileCount; ++y)
+            for(int x = 0; x < xTileCount; ++x)
+                ctx.tiles.push_back(pair<int,int>(x, y));
+
+        int threadCount = rcMin(m_threads, int(ctx.tiles.size()));
+        if(threadCount <= 1)
+            processTileQueue(ctx);
+        else
         {
-            // set tile bounds
-            bmin[0] = yMin + GRID_SIZE*y;
-            bmax[0] = bmin[0] + GRID_SIZE;
+            vector<TileBuildWorker*> workers;
+            for(int i = 0; i < threadCount; ++i)
+            {
+                TileBuildWorker* worker = new TileBuildWorker(this, &ctx);
+                if(worker->start())
+                    workers.push_back(worker);
+                else
+                    delete worker;
+            }
 
-            for(int x = 0; x < xTileCount; ++x)
+            // could not start any thread, do the work ourselves
+            if(workers.empty())
+                processTileQueue(ctx);
+
+            for(vector<TileBuildWorker*>::iterator it = workers.begin(); it != workers.end(); ++it)
             {
-                // re-initialize
-                // do it at the start of each iteration!!
-                clearIntermediateValues(iv);
-
-                // set tile bounds
-                bmin[2] = xMin + GRID_SIZE*x;
-                bmax[2] = bmin[2] + GRID_SIZE;
-                rcVcopy(config.bmin, bmin);
-                rcVcopy(config.bmax, bmax);
-
-                // pad bounds with a border
-                config.bmin[0] -= config.borderSize*config.cs;
-                config.bmin[2] -= config.borderSize*config.cs;
-                config.bmax[0] += config.borderSize*config.cs;
-                config.bmax[2] += config.borderSize*config.cs;
-
-                // this sets the dimensions of the heightfield - should maybe happen before border padding
-                rcCalcGridSize(config.bmin, config.bmax, config.cs, &config.width, &config.height);
-
-                // set tile string
-                tileY = 32-((bmin[0] + bmax[0]) / 2)/GRID_SIZE;
-                tileX = 32-((bmin[2] + bmax[2]) / 2)/GRID_SIZE;
-                sprintf(tileString, "[%02i,%02i]: ", tileX, tileY);
-
-                // build heightfield
-                printf("%sBuilding Recast Heightfield...          \r", tileString);
-                iv.heightfield = new rcHeightfield;
-                if(!rcCreateHeightfield(*iv.heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
-                {
-                    printf("%sFailed building heightfield!            \n", tileString);
-                    continue;
-                }
-
-                // select proper triangles
-                iv.triFlags = new unsigned char[chunkyMesh->maxTrisPerChunk];
-                float tbmin[2], tbmax[2];
-                tbmin[0] = config.bmin[0];
-                tbmin[1] = config.bmin[2];
-                tbmax[0] = config.bmax[0];
-                tbmax[1] = config.bmax[2];
-                const static int chunksPerTile = 4096;
-                int cid[chunksPerTile];
-                const int ncid = rcGetChunksInRect(chunkyMesh, tbmin, tbmax, cid, chunksPerTile);
-                if(!ncid)
-                {
-                    // tiles with MAP_HEIGHT_NO_HEIGHT are usually empty, they can be skipped
-                    continue;
-                }
-                if(ncid > chunksPerTile)
-                    printf("%sHave %i chunks, but we can only use %i!\n", ncid, chunksPerTile);
-
-                // rasterize triangles
-                printf("%sRasterizing triangles...                \r", tileString);
-                int tileTriCount = 0;
-                for(int i = 0; i < ncid; ++i)
-                {
-                    const rcChunkyTriMeshNode& node = chunkyMesh->nodes[cid[i]];
-                    const int* nodeTris = &chunkyMesh->tris[node.i*3];
-                    const int nNodeTris = node.n;
-
-                    tileTriCount += nNodeTris;
-
-                    memset(iv.triFlags, 0, nNodeTris*sizeof(unsigned char));
-                    rcMarkWalkableTriangles(config.walkableSlopeAngle, verts, vertCount, nodeTris, nNodeTris, iv.triFlags);
-                    rcRasterizeTriangles(verts, vertCount, nodeTris, iv.triFlags, nNodeTris, *iv.heightfield, config.walkableClimb);
-                }
-
-                delete [] iv.triFlags;
-                iv.triFlags = 0;
-
-                // filter out unusable rasterization data (order of calls matters)
-                printf("%sFiltering low obstacles...              \r", tileString);
-                rcFilterLowHangingWalkableObstacles(config.walkableClimb, *iv.heightfield);
-
-                printf("%sFiltering edges...                      \r", tileString);
-                rcFilterLedgeSpans(config.walkableHeight, config.walkableClimb, *iv.heightfield);
-
-                printf("%sFiltering low-clearance areas...        \r", tileString);
-                rcFilterWalkableLowHeightSpans(config.walkableHeight, *iv.heightfield);
-
-                printf("%sCompacting heightfield...               \r", tileString);
-                iv.compactHeightfield = new rcCompactHeightfield;
-                if(!rcBuildCompactHeightfield(config.walkableHeight, config.walkableClimb, RC_WALKABLE, *iv.heightfield, *iv.compactHeightfield))
-                {
-                    printf("%sFailed compacting heightfield!            \n", tileString);
-                    continue;
-                }
-
-                if(!m_debugOutput)
-                {
-                    delete iv.heightfield;
-                    iv.heightfield = 0;
-                }
-
-                // build polymesh intermediates
-                printf("%sEroding walkable area width...          \r", tileString);
-                if(!rcErodeArea(RC_WALKABLE_AREA, config.walkableRadius, *iv.compactHeightfield))
-                {
-                    printf("%sFailed eroding area!                    \n", tileString);
-                    continue;
-                }
-
-                printf("%sBuilding distance field...              \r", tileString);
-                if(!rcBuildDistanceField(*iv.compactHeightfield))
-                {
-                    printf("%sFailed building distance field!         \n", tileString);
-                    continue;
-                }
-
-                // bottleneck is here
-                printf("%sBuilding regions...                     \r", tileString);
-                if(!rcBuildRegions(*iv.compactHeightfield, config.borderSize, config.minRegionSize, config.mergeRegionSize))
-                {
-                    printf("%sFailed building regions!                \n", tileString);
-                    continue;
-                }
-
-                printf("%sBuilding contours...                    \r", tileString);
-                iv.contours = new rcContourSet;
-                if(!rcBuildContours(*iv.compactHeightfield, config.maxSimplificationError, config.maxEdgeLen, *iv.contours))
-                {
-                    printf("%sFailed building contours!               \n", tileString);
-                    continue;
-                }
-
-                // build polymesh
-                printf("%sBuilding polymesh...                    \r", tileString);
-                iv.polyMesh = new rcPolyMesh;
-                if(!rcBuildPolyMesh(*iv.contours, config.maxVertsPerPoly, *iv.polyMesh))
-                {
-                    printf("%sFailed building polymesh!               \n", tileString);
-                    continue;
-                }
-
-                printf("%sBuilding polymesh detail...             \r", tileString);
-                iv.polyMeshDetail = new rcPolyMeshDetail;
-                if(!rcBuildPolyMeshDetail(*iv.polyMesh, *iv.compactHeightfield, config.detailSampleDist, config.detailSampleMaxError, *iv.polyMeshDetail))
-                {
-                    printf("%sFailed building polymesh detail!        \n", tileString);
-                    continue;
-                }
-
-                if(!m_debugOutput)
-                {
-                    delete iv.compactHeightfield; iv.compactHeightfield = 0;
-                    delete iv.contours; iv.contours = 0;
-                }
-
-                // this might be handled within Recast at some point
-                printf("%sCleaning vertex padding...              \r", tileString);
-                for(int i = 0; i < iv.polyMesh->nverts; ++i)
-                {
-                    unsigned short* v = &iv.polyMesh->verts[i*3];
-                    v[0] -= (unsigned short)config.borderSize;
-                    v[2] -= (unsigned short)config.borderSize;
-                }
-
-                // polymesh vertex indices are stored with ushorts in detour, can't have more than 65535
-                if(iv.polyMesh->nverts >= 0xffff)
-                {
-                    printf("%sToo many vertices!                      \n", tileString);
-                    continue;
-                }
-
-                // TODO: implement flags
-                printf("%sSetting polys as walkable...            \r", tileString);
-                for(int i = 0; i < iv.polyMesh->npolys; ++i)
-                    if(iv.polyMesh->areas[i] == RC_WALKABLE_AREA)
-                        //iv.polyMesh->areas[i] = 0;
-                        iv.polyMesh->flags[i] = 1;
-
-                dtNavMeshCreateParams params;
-                memset(&params, 0, sizeof(params));
-                params.verts = iv.polyMesh->verts;
-                params.vertCount = iv.polyMesh->nverts;
-                params.polys = iv.polyMesh->polys;
-                params.polyAreas = iv.polyMesh->areas;
-                params.polyFlags = iv.polyMesh->flags;
-                params.polyCount = iv.polyMesh->npolys;
-                params.nvp = iv.polyMesh->nvp;
-                params.detailMeshes = iv.polyMeshDetail->meshes;
-                params.detailVerts = iv.polyMeshDetail->verts;
-                params.detailVertsCount = iv.polyMeshDetail->nverts;
-                params.detailTris = iv.polyMeshDetail->tris;
-                params.detailTriCount = iv.polyMeshDetail->ntris;
-                params.walkableHeight = agentHeight;
-                params.walkableRadius = agentRadius;
-                params.walkableClimb = agentMaxClimb;
-                params.tileX = (((bmin[0] + bmax[0]) / 2) - navMesh->getParams()->orig[0]) / GRID_SIZE;
-                params.tileY = (((bmin[2] + bmax[2]) / 2) - navMesh->getParams()->orig[2]) / GRID_SIZE;
-                rcVcopy(params.bmin, bmin);
-                rcVcopy(params.bmax, bmax);
-                params.cs = config.cs;
-                params.ch = config.ch;
-                params.tileSize = config.tileSize;
-
-                // will hold final navmesh
-                unsigned char* navData = 0;
-                int navDataSize = 0;
-
-                // these values are checked within dtCreateNavMeshData - handle them here
-                // so we have a clear error message
-                if (params.nvp > DT_VERTS_PER_POLYGON)
-                {
-                    printf("%sInvalid verts-per-polygon value!        \n", tileString);
-                    continue;
-                }
-                if (params.vertCount >= 0xffff)
-                {
-                    printf("%sToo many vertices!                      \n", tileString);
-                    continue;
-                }
-                if (!params.vertCount || !params.verts)
-                {
-                    //printf("%sNo vertices to build navMesh!           \n", tileString);
-                    continue;
-                }
-                if (!params.polyCount || !params.polys)
-                {
-                    printf("%sNo polygons to build navMesh!           \n", tileString);
-                    continue;
-                }
-                if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
-                {
-                    printf("%sNo detail mesh to build navMesh!        \n", tileString);
-                    continue;
-                }
-
-                printf("%sBuilding navmesh tile...                \r", tileString);
-                if(!dtCreateNavMeshData(&params, &navData, &navDataSize))
-                {
-                    printf("%sFailed building navmesh tile!           \n", tileString);
-                    delete [] navData;
-                    continue;
-                }
-
-                dtTileRef tileRef = 0;
-                printf("%Adding tile to navmesh...                \r", tileString);
-                // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-                // is removed via removeTile()
-                if(!(tileRef = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA)))
-                {
-                    printf("%Failed adding tile to navmesh!           \n", tileString);
-                    delete [] navData;
-                    continue;
-                }
-
-                sprintf(fileName, "mmaps\\%03u%02i%02i.mmtile", mapID, tileX, tileY);
-                if(!(file = fopen(fileName, "wb")))
-                {
-                    printf("%sFailed to open %s for writing!\n",  tileString, fileName);
-                    navMesh->removeTile(tileRef, 0, 0);
-                    continue;
-                }
-
-                printf("%sWriting to file...                      \r", tileString);
-                // should write navDataSize first... for now, just use ftell to find length when reading
-                fwrite(navData, sizeof(unsigned char), navDataSize, file);
-                fclose(file);
-
-                if(m_debugOutput)
-                    writeIV(mapID, tileX, tileY, iv);
-
-                // now that tile is written to disk, we can unload it
-                navMesh->removeTile(tileRef, 0, 0);
+                (*it)->wait();
+                delete (*it);
             }
         }
 
         // cleanup
         delete chunkyMesh;
+    }
+
+    void MapBuilder::processTileQueue(TileBuildContext &ctx)
+    {
+        dtNavMesh* navMesh = new dtNavMesh;
+        if(!navMesh->init(&ctx.navMeshParams))
+        {
+            printf("Failed creating navmesh!                \n");
+            delete navMesh;
+            return;
+        }
+
+        IntermediateValues iv;
+        initIntermediateValues(iv);
+
+        while(true)
+        {
+            pair<int,int> tile;
+            {
+                Guard guard(ctx.tileLock);
+                if(ctx.nextTile >= ctx.tiles.size())
+                    break;
+                tile = ctx.tiles[ctx.nextTile++];
+            }
+
+            buildMoveMapTile(ctx, navMesh, tile.first, tile.second, iv);
+
+            // re-initialize, tile build may bail out anywhere
+            clearIntermediateValues(iv);
+        }
+
         delete navMesh;
-        clearIntermediateValues(iv);
+    }
+
+    void MapBuilder::buildMoveMapTile(TileBuildContext &ctx, dtNavMesh* navMesh, int x, int y, IntermediateValues &iv)
+    {
+        const uint32 mapID = ctx.mapID;
+        const float agentHeight = ctx.agentHeight;
+        const float agentRadius = ctx.agentRadius;
+        const float agentMaxClimb = ctx.agentMaxClimb;
+        float* verts = ctx.verts;
+        const int vertCount = ctx.vertCount;
+        rcChunkyTriMesh* chunkyMesh = ctx.chunkyMesh;
+
+        char fileName[25];
+        FILE* file = 0;
+        char tileString[10]; // "[xx,yy]: "
+        int tileX, tileY;
+
+        // set tile bounds
+        rcConfig config = ctx.config;
+        float bmin[3], bmax[3];
+        rcVcopy(bmin, config.bmin);
+        rcVcopy(bmax, config.bmax);
+        bmin[0] = ctx.yMin + GRID_SIZE*y;
+        bmax[0] = bmin[0] + GRID_SIZE;
+        bmin[2] = ctx.xMin + GRID_SIZE*x;
+        bmax[2] = bmin[2] + GRID_SIZE;
+        rcVcopy(config.bmin, bmin);
+        rcVcopy(config.bmax, bmax);
+
+        // pad bounds with a border
+        config.bmin[0] -= config.borderSize*config.cs;
+        config.bmin[2] -= config.borderSize*config.cs;
+        config.bmax[0] += config.borderSize*config.cs;
+        config.bmax[2] += config.borderSize*config.cs;
+
+        // this sets the dimensions of the heightfield - should maybe happen before border padding
+        rcCalcGridSize(config.bmin, config.bmax, config.cs, &config.width, &config.height);
+
+        // set tile string
+        tileY = 32-((bmin[0] + bmax[0]) / 2)/GRID_SIZE;
+        tileX = 32-((bmin[2] + bmax[2]) / 2)/GRID_SIZE;
+        sprintf(tileString, "[%02i,%02i]: ", tileX, tileY);
+
+        // build heightfield
+        printf("%sBuilding Recast Heightfield...          \r", tileString);
+        iv.heightfield = new rcHeightfield;
+        if(!rcCreateHeightfield(*iv.heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
+        {
+            printf("%sFailed building heightfield!            \n", tileString);
+            return;
+        }
+
+        // select proper triangles
+        iv.triFlags = new unsigned char[chunkyMesh->maxTrisPerChunk];
+        float tbmin[2], tbmax[2];
+        tbmin[0] = config.bmin[0];
+        tbmin[1] = config.bmin[2];
+        tbmax[0] = config.bmax[0];
+        tbmax[1] = config.bmax[2];
+        const static int chunksPerTile = 4096;
+        int cid[chunksPerTile];
+        const int ncid = rcGetChunksInRect(chunkyMesh, tbmin, tbmax, cid, chunksPerTile);
+        if(!ncid)
+        {
+            // tiles with MAP_HEIGHT_NO_HEIGHT are usually empty, they can be skipped
+            return;
+        }
+        if(ncid > chunksPerTile)
+            printf("%sHave %i chunks, but we can only use %i!\n", ncid, chunksPerTile);
+
+        // rasterize triangles
+        printf("%sRasterizing triangles...                \r", tileString);
+        int tileTriCount = 0;
+        for(int i = 0; i < ncid; ++i)
+        {
+            const rcChunkyTriMeshNode& node = chunkyMesh->nodes[cid[i]];
+            const int* nodeTris = &chunkyMesh->tris[node.i*3];
+            const int nNodeTris = node.n;
+
+            tileTriCount += nNodeTris;
+
+            memset(iv.triFlags, 0, nNodeTris*sizeof(unsigned char));
+            rcMarkWalkableTriangles(config.walkableSlopeAngle, verts, vertCount, nodeTris, nNodeTris, iv.triFlags);
+            rcRasterizeTriangles(verts, vertCount, nodeTris, iv.triFlags, nNodeTris, *iv.heightfield, config.walkableClimb);
+        }
+
+        delete [] iv.triFlags;
+        iv.triFlags = 0;
+
+        // filter out unusable rasterization data (order of calls matters)
+        printf("%sFiltering low obstacles...              \r", tileString);
+        rcFilterLowHangingWalkableObstacles(config.walkableClimb, *iv.heightfield);
+
+        printf("%sFiltering edges...                      \r", tileString);
+        rcFilterLedgeSpans(config.walkableHeight, config.walkableClimb, *iv.heightfield);
+
+        printf("%sFiltering low-clearance areas...        \r", tileString);
+        rcFilterWalkableLowHeightSpans(config.walkableHeight, *iv.heightfield);
+
+        printf("%sCompacting heightfield...               \r", tileString);
+        iv.compactHeightfield = new rcCompactHeightfield;
+        if(!rcBuildCompactHeightfield(config.walkableHeight, config.walkableClimb, RC_WALKABLE, *iv.heightfield, *iv.compactHeightfield))
+        {
+            printf("%sFailed compacting heightfield!            \n", tileString);
+            return;
+        }
+
+        if(!m_debugOutput)
+        {
+            delete iv.heightfield;
+            iv.heightfield = 0;
+        }
+
+        // build polymesh intermediates
+        printf("%sEroding walkable area width...          \r", tileString);
+        if(!rcErodeArea(RC_WALKABLE_AREA, config.walkableRadius, *iv.compactHeightfield))
+        {
+            printf("%sFailed eroding area!                    \n", tileString);
+            return;
+        }
+
+        printf("%sBuilding distance field...              \r", tileString);
+        if(!rcBuildDistanceField(*iv.compactHeightfield))
+        {
+            printf("%sFailed building distance field!         \n", tileString);
+            return;
+        }
+
+        // bottleneck is here
+        printf("%sBuilding regions...                     \r", tileString);
+        if(!rcBuildRegions(*iv.compactHeightfield, config.borderSize, config.minRegionSize, config.mergeRegionSize))
+        {
+            printf("%sFailed building regions!                \n", tileString);
+            return;
+        }
+
+        printf("%sBuilding contours...                    \r", tileString);
+        iv.contours = new rcContourSet;
+        if(!rcBuildContours(*iv.compactHeightfield, config.maxSimplificationError, config.maxEdgeLen, *iv.contours))
+        {
+            printf("%sFailed building contours!               \n", tileString);
+            return;
+        }
+
+        // build polymesh
+        printf("%sBuilding polymesh...                    \r", tileString);
+        iv.polyMesh = new rcPolyMesh;
+        if(!rcBuildPolyMesh(*iv.contours, config.maxVertsPerPoly, *iv.polyMesh))
+        {
+            printf("%sFailed building polymesh!               \n", tileString);
+            return;
+        }
+
+        printf("%sBuilding polymesh detail...             \r", tileString);
+        iv.polyMeshDetail = new rcPolyMeshDetail;
+        if(!rcBuildPolyMeshDetail(*iv.polyMesh, *iv.compactHeightfield, config.detailSampleDist, config.detailSampleMaxError, *iv.polyMeshDetail))
+        {
+            printf("%sFailed building polymesh detail!        \n", tileString);
+            return;
+        }
+
+        if(!m_debugOutput)
+        {
+            delete iv.compactHeightfield; iv.compactHeightfield = 0;
+            delete iv.contours; iv.contours = 0;
+        }
+
+        // this might be handled within Recast at some point
+        printf("%sCleaning vertex padding...              \r", tileString);
+        for(int i = 0; i < iv.polyMesh->nverts; ++i)
+        {
+            unsigned short* v = &iv.polyMesh->verts[i*3];
+            v[0] -= (unsigned short)config.borderSize;
+            v[2] -= (unsigned short)config.borderSize;
+        }
+
+        // polymesh vertex indices are stored with ushorts in detour, can't have more than 65535
+        if(iv.polyMesh->nverts >= 0xffff)
+        {
+            printf("%sToo many vertices!                      \n", tileString);
+            return;
+        }
+
+        // TODO: implement flags
+        printf("%sSetting polys as walkable...            \r", tileString);
+        for(int i = 0; i < iv.polyMesh->npolys; ++i)
+            if(iv.polyMesh->areas[i] == RC_WALKABLE_AREA)
+                //iv.polyMesh->areas[i] = 0;
+                iv.polyMesh->flags[i] = 1;
+
+        dtNavMeshCreateParams params;
+        memset(&params, 0, sizeof(params));
+        params.verts = iv.polyMesh->verts;
+        params.vertCount = iv.polyMesh->nverts;
+        params.polys = iv.polyMesh->polys;
+        params.polyAreas = iv.polyMesh->areas;
+        params.polyFlags = iv.polyMesh->flags;
+        params.polyCount = iv.polyMesh->npolys;
+        params.nvp = iv.polyMesh->nvp;
+        params.detailMeshes = iv.polyMeshDetail->meshes;
+        params.detailVerts = iv.polyMeshDetail->verts;
+        params.detailVertsCount = iv.polyMeshDetail->nverts;
+        params.detailTris = iv.polyMeshDetail->tris;
+        params.detailTriCount = iv.polyMeshDetail->ntris;
+        params.walkableHeight = agentHeight;
+        params.walkableRadius = agentRadius;
+        params.walkableClimb = agentMaxClimb;
+        params.tileX = (((bmin[0] + bmax[0]) / 2) - navMesh->getParams()->orig[0]) / GRID_SIZE;
+        params.tileY = (((bmin[2] + bmax[2]) / 2) - navMesh->getParams()->orig[2]) / GRID_SIZE;
+        rcVcopy(params.bmin, bmin);
+        rcVcopy(params.bmax, bmax);
+        params.cs = config.cs;
+        params.ch = config.ch;
+        params.tileSize = config.tileSize;
+
+        // will hold final navmesh
+        unsigned char* navData = 0;
+        int navDataSize = 0;
+
+        // these values are checked within dtCreateNavMeshData - handle them here
+        // so we have a clear error message
+        if (params.nvp > DT_VERTS_PER_POLYGON)
+        {
+            printf("%sInvalid verts-per-polygon value!        \n", tileString);
+            return;
+        }
+        if (params.vertCount >= 0xffff)
+        {
+            printf("%sToo many vertices!                      \n", tileString);
+            return;
+        }
+        if (!params.vertCount || !params.verts)
+        {
+            //printf("%sNo vertices to build navMesh!           \n", tileString);
+            return;
+        }
+        if (!params.polyCount || !params.polys)
+        {
+            printf("%sNo polygons to build navMesh!           \n", tileString);
+            return;
+        }
+        if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
+        {
+            printf("%sNo detail mesh to build navMesh!        \n", tileString);
+            return;
+        }
+
+        printf("%sBuilding navmesh tile...                \r", tileString);
+        if(!dtCreateNavMeshData(&params, &navData, &navDataSize))
+        {
+            printf("%sFailed building navmesh tile!           \n", tileString);
+            delete [] navData;
+            return;
+        }
+
+        // write the tile before adding it to the navmesh, addTile patches links into navData
+        // and their content depends on what else was loaded - keeps output independent of build order
+        sprintf(fileName, "mmaps\\%03u%02i%02i.mmtile", mapID, tileX, tileY);
+        if(!(file = fopen(fileName, "wb")))
+        {
+            printf("%sFailed to open %s for writing!\n",  tileString, fileName);
+            delete [] navData;
+            return;
+        }
+
+        printf("%sWriting to file...                      \r", tileString);
+        // should write navDataSize first... for now, just use ftell to find length when reading
+        fwrite(navData, sizeof(unsigned char), navDataSize, file);
+        fclose(file);
+
+        dtTileRef tileRef = 0;
+        printf("%Adding tile to navmesh...                \r", tileString);
+        // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
+        // is removed via removeTile()
+        if(!(tileRef = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA)))
+        {
+            printf("%Failed adding tile to navmesh!           \n", tileString);
+            remove(fileName);
+            delete [] navData;
+            return;
+        }
+
+        if(m_debugOutput)
+            writeIV(mapID, tileX, tileY, iv);
+
+        // tile is written to disk and validated, we can unload it
+        navMesh->removeTile(tileRef, 0, 0);
     }
 
     void MapBuilder::initIntermediateValues(IntermediateValues &iv)
@@ -11,6 +11,7 @@
 
 #include "ChunkyTriMesh.h"
 #include "pathfinding/Recast/Recast.h"
+#include "pathfinding/Detour/DetourNavMesh.h"
 
 using namespace std;
 using namespace VMAP;
@@ -34,8 +35,35 @@ namespace MMAP
         rcPolyMeshDetail* polyMeshDetail;
     };
 
+    // data shared by all tile workers of one map, read only except for the tile queue
+    struct TileBuildContext
+    {
+        uint32 mapID;
+        rcConfig config;
+        dtNavMeshParams navMeshParams;
+        float agentHeight;
+        float agentRadius;
+        float agentMaxClimb;
+        float yMin;
+        float xMin;
+
+        float* verts;
+        int vertCount;
+        int* tris;
+        rcChunkyTriMesh* chunkyMesh;
+
+        // (x, y) tile indices, handed out to workers in order
+        vector<pair<int,int> > tiles;
+        uint32 nextTile;
+        Mutex tileLock;
+    };
+
+    class TileBuildWorker;
+
     class MapBuilder
     {
+        friend class TileBuildWorker;
+
         public:
             MapBuilder(float maxWalkableAngle   = 60.f,
                        bool skipContinents      = true,
@@ -43,7 +71,8 @@ namespace MMAP
                        bool skipBattlegrounds   = true,
                        bool hiResHeightmaps     = false,
                        bool shredHeightmaps     = true,
-                       bool debugOutput         = false);
+                       bool debugOutput         = false,
+                       int threads              = 1);
 
             ~MapBuilder();
 
@@ -61,6 +90,7 @@ namespace MMAP
 
              * Fourth, data is sent off to recast for processing.  This optionally includes generating
                an obj file, for debugging with RecastDemo
+               Tiles are independent of each other and are built by a pool of m_threads workers.
                TODO: benchmark recast with and without steep inclines
                TODO: attempt to optimize rcBuildRegions
             */
@@ -95,19 +125,26 @@ namespace MMAP
              applies the specified scale, rotation, and translation to all vertices in the model
              results are copied to a new vector so that original data may be reused
             */
-            void transform(vector<Vector3> original, vector<Vector3> &transformed, float scale, G3D::Matrix3 rotation, Vector3 position);
+            void transform(const vector<Vector3> &original, vector<Vector3> &transformed, float scale, const G3D::Matrix3 &rotation, const Vector3 &position);
 
             /**
              appends (the data from source) to (dest)
             */
-            void copyVertices(vector<Vector3> source, vector<float> &dest);
+            void copyVertices(const vector<Vector3> &source, vector<float> &dest);
 
             /**
              appends (the data from source) to (dest), incrementing each entry by offset, and optionaly 
              inverts the order of each set of indices (M2 models are 'insideout')
             */
-            void copyIndices(vector<MeshTriangle> source, vector<int> &dest, int offest, bool flip);
+            void copyIndices(const vector<MeshTriangle> &source, vector<int> &dest, int offest, bool flip);
             void buildMoveMap(uint32 mapID);
+
+            /**
+             pulls tiles from the context queue until it is empty, called by every worker thread
+             each worker validates its tiles against its own navmesh, so workers share no mutable state
+            */
+            void processTileQueue(TileBuildContext &ctx);
+            void buildMoveMapTile(TileBuildContext &ctx, dtNavMesh* navMesh, int x, int y, IntermediateValues &iv);
             void initIntermediateValues(IntermediateValues &iv);
             void clearIntermediateValues(IntermediateValues &iv);
 
@@ -157,6 +194,7 @@ namespace MMAP
 
             bool m_debugOutput;
             bool m_completeLists;
+            int m_threads;
 
             bool m_skipContinents;
             bool m_skipJunkMaps;
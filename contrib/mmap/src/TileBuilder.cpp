@@ -332,8 +332,7 @@ namespace MMAP
             if(!worldModel)
                 continue;
 
-            vector<GroupModel> groupModels;
-            worldModel->getGroupModels(groupModels);
+            const vector<GroupModel> &groupModels = worldModel->getGroupModels();
 
             // all M2s need to have triangle indices reversed
             bool isM2 = instance.name.find(".m2") != instance.name.npos || instance.name.find(".M2") != instance.name.npos;
@@ -346,19 +345,15 @@ namespace MMAP
             position.y -= 32*533.33333f;
             position.z += m_heightOffset;
 
-            for(vector<GroupModel>::iterator it = groupModels.begin(); it != groupModels.end(); ++it)
+            for(vector<GroupModel>::const_iterator it = groupModels.begin(); it != groupModels.end(); ++it)
             {
-                vector<Vector3> tempVertices;
                 vector<Vector3> transformedVertices;
-                vector<MeshTriangle> tempTriangles;
 
-                (*it).getMeshData(tempVertices, tempTriangles);
-
-                transform(tempVertices, transformedVertices, scale, rotation, position);
+                transform((*it).getVertices(), transformedVertices, scale, rotation, position);
 
                 int offset = modelVertices->size() / 3;
                 copyVertices(transformedVertices, (*modelVertices));
-                copyIndices(tempTriangles, (*modelTriangles), offset, isM2);
+                copyIndices((*it).getTriangles(), (*modelTriangles), offset, isM2);
             }
 
             m_modelsVertices.push_back(modelVertices);
@@ -366,15 +361,15 @@ namespace MMAP
         }
     }
 
-    inline void TileBuilder::transform(vector<Vector3> source, vector<Vector3> &transformedVertices, float scale, G3D::Matrix3 rotation, Vector3 position)
+    inline void TileBuilder::transform(const vector<Vector3> &source, vector<Vector3> &transformedVertices, float scale, const G3D::Matrix3 &rotation, const Vector3 &position)
     {
-        for(vector<Vector3>::iterator it = source.begin(); it != source.end(); ++it)
+        for(vector<Vector3>::const_iterator it = source.begin(); it != source.end(); ++it)
             transformedVertices.push_back((*it) * rotation * scale + position);
     }
 
-    inline void TileBuilder::copyVertices(vector<Vector3> source, vector<float> dest)
+    inline void TileBuilder::copyVertices(const vector<Vector3> &source, vector<float> dest)
     {
-        for(vector<Vector3>::iterator it = source.begin(); it != source.end(); ++it)
+        for(vector<Vector3>::const_iterator it = source.begin(); it != source.end(); ++it)
         {
             dest.push_back((*it).y);
             dest.push_back((*it).z);
@@ -382,12 +377,12 @@ namespace MMAP
         }
     }
 
-    inline void TileBuilder::copyIndices(vector<MeshTriangle> source, vector<int> dest, int offset, bool flip)
+    inline void TileBuilder::copyIndices(const vector<MeshTriangle> &source, vector<int> dest, int offset, bool flip)
     {
         // evaluate flip once, makes faster code (but larger)
         if(flip)
         {
-            for(vector<MeshTriangle>::iterator it = source.begin(); it != source.end(); ++it)
+            for(vector<MeshTriangle>::const_iterator it = source.begin(); it != source.end(); ++it)
             {
                 dest.push_back((*it).idx2+offset);
                 dest.push_back((*it).idx1+offset);
@@ -396,7 +391,7 @@ namespace MMAP
         }
         else
         {
-            for(vector<MeshTriangle>::iterator it = source.begin(); it != source.end(); ++it)
+            for(vector<MeshTriangle>::const_iterator it = source.begin(); it != source.end(); ++it)
             {
                 dest.push_back((*it).idx0+offset);
                 dest.push_back((*it).idx1+offset);
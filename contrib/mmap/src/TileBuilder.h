@@ -75,9 +75,9 @@ namespace MMAP
             vector<vector<int>*> m_modelsTriangles;
 
             void loadModels();
-            void transform(vector<Vector3> original, vector<Vector3> &transformed, float scale, G3D::Matrix3 rotation, Vector3 position);
-            void copyVertices(vector<Vector3> source, vector<float> dest);                              // copies vertices into m_vertices
-            void copyIndices(vector<MeshTriangle> source, vector<int> dest, int offest, bool flip);   // copies vertex index data into m_triangleIndices
+            void transform(const vector<Vector3> &original, vector<Vector3> &transformed, float scale, const G3D::Matrix3 &rotation, const Vector3 &position);
+            void copyVertices(const vector<Vector3> &source, vector<float> dest);                             // copies vertices into m_vertices
+            void copyIndices(const vector<MeshTriangle> &source, vector<int> dest, int offest, bool flip);   // copies vertex index data into m_triangleIndices
 
             // intersection of heightmap and models
             void intersect();
@@ -24,16 +24,21 @@ namespace VMAP
     }
 
     // declared in src/shared/vmap/WorldModel.h
-    void WorldModel::getGroupModels(vector<GroupModel> &groupModels)
+    const vector<GroupModel>& WorldModel::getGroupModels() const
     {
-        groupModels = this->groupModels;
+        return this->groupModels;
     }
-    
+
+    // declared in src/shared/vmap/WorldModel.h
+    vector<Vector3> GroupModel::getVertices() const
+    {
+        return vector<Vector3>(this->vertices.begin(), this->vertices.end());
+    }
+
     // declared in src/shared/vmap/WorldModel.h
-    void GroupModel::getMeshData(vector<Vector3> &vertices, vector<MeshTriangle> &triangles)
+    vector<MeshTriangle> GroupModel::getTriangles() const
     {
-        vertices = this->vertices;
-        triangles = this->triangles;
+        return vector<MeshTriangle>(this->triangles.begin(), this->triangles.end());
     }
 
     // declared in src/shared/vmap/ModelInstance.h
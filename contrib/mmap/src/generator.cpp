@@ -53,6 +53,7 @@ void handleArgs(int argc, char** argv,
                bool &hiResHeightmaps,
                bool &shredHeightmaps,
                bool &debugOutput,
+               int &threads,
                bool &invalidMapNum)
 {
     int i;
@@ -128,6 +129,15 @@ void handleArgs(int argc, char** argv,
             else
                 printf("invalid option for '--debugOutput', using default true\n");
         }
+        else if(strcmp(argv[i], "--threads") == 0)
+        {
+            param = argv[++i];
+            int threadCount = atoi(param);
+            if(threadCount > 0)
+                threads = threadCount;
+            else
+                printf("invalid option for '--threads', using default\n");
+        }
         else
         {
             int map = atoi(argv[i]);
@@ -152,6 +162,7 @@ int finish(char* message, int returnValue)
 int main(int argc, char** argv)
 {
     int mapnum = -1;
+    int threads = 1;
     float maxAngle = 60.f;
     bool skipContinents = true,
          skipJunkMaps = true,
@@ -171,6 +182,7 @@ int main(int argc, char** argv)
               hiResHeightmaps,
               shredHeightmaps,
               debugOutput,
+              threads,
               invalidMapNum);
 
     if(invalidMapNum)
@@ -197,7 +209,8 @@ int main(int argc, char** argv)
                        skipBattlegrounds,
                        hiResHeightmaps,
                        shredHeightmaps,
-                       debugOutput);
+                       debugOutput,
+                       threads);
 
     if(mapnum >= 0)
         builder.build(uint32(mapnum));
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Convert binary world packet capture (WorldLogFile) to text packet log
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "PacketCapture.h"
+
+#ifdef WIN32
+#pragma warning (disable:4996)
+#endif
+
+typedef unsigned char       uint8;
+typedef unsigned short      uint16;
+typedef unsigned int        uint32;
+#ifdef WIN32
+typedef unsigned __int64    uint64;
+#else
+typedef unsigned long long  uint64;
+#endif
+
+class CaptureReader
+{
+    public:
+        explicit CaptureReader(FILE* in) : m_in(in) {}
+
+        bool read(void* dest, size_t size) { return fread(dest, 1, size, m_in) == size; }
+
+        // values are stored little endian, assemble byte by byte for any host order
+        bool readUInt(uint64& value, size_t size)
+        {
+            uint8 buf[8];
+            if (!read(buf, size))
+                return false;
+
+            value = 0;
+            for (size_t i = size; i > 0; --i)
+                value = (value << 8) | buf[i-1];
+            return true;
+        }
+
+        bool readUInt8(uint8& value)   { uint64 v; if (!readUInt(v, 1)) return false; value = uint8(v); return true; }
+        bool readUInt16(uint16& value) { uint64 v; if (!readUInt(v, 2)) return false; value = uint16(v); return true; }
+        bool readUInt32(uint32& value) { uint64 v; if (!readUInt(v, 4)) return false; value = uint32(v); return true; }
+        bool readUInt64(uint64& value) { return readUInt(value, 8); }
+
+    private:
+        FILE* m_in;
+};
+
+typedef std::map<uint16, std::string> OpcodeNames;
+
+void writePacket(FILE* out, uint64 msTime, uint8 direction, uint32 socket, uint16 opcode, char const* opcodeName, std::vector<uint8> const& data)
+{
+    // same layout as text dump written by server
+    time_t t = time_t(msTime / 1000);
+    tm* aTm = localtime(&t);
+    fprintf(out,"%-4d-%02d-%02d %02d:%02d:%02d ",aTm->tm_year+1900,aTm->tm_mon+1,aTm->tm_mday,aTm->tm_hour,aTm->tm_min,aTm->tm_sec);
+
+    fprintf(out,"\n%s:\nSOCKET: %u\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+        direction == PACKET_CAPTURE_CLIENT ? "CLIENT" : "SERVER",
+        socket, uint32(data.size()), opcodeName, opcode);
+
+    size_t p = 0;
+    while (p < data.size())
+    {
+        for (size_t j = 0; j < 16 && p < data.size(); ++j)
+            fprintf(out, "%.2X ", data[p++]);
+
+        fprintf(out, "\n");
+    }
+
+    fprintf(out, "\n\n");
+}
+
+bool convert(FILE* in, FILE* out)
+{
+    CaptureReader reader(in);
+    OpcodeNames names;
+    std::vector<uint8> data;
+    uint32 packets = 0;
+
+    uint8 chunk;
+    while (reader.readUInt8(chunk))
+    {
+        switch (chunk)
+        {
+            case PACKET_CAPTURE_SESSION:
+            {
+                char magic[4];
+                uint16 version;
+                if (!reader.read(magic, 4) || !reader.readUInt16(version))
+                    break;
+
+                if (memcmp(magic, PACKET_CAPTURE_MAGIC, 4) != 0 || version != PACKET_CAPTURE_VERSION)
+                {
+                    printf("Unsupported capture session (version %u)\n", version);
+                    return false;
+                }
+
+                // names are written again for new session
+                names.clear();
+                continue;
+            }
+            case PACKET_CAPTURE_OPCODE:
+            {
+                uint16 opcode;
+                uint8 len;
+                if (!reader.readUInt16(opcode) || !reader.readUInt8(len))
+                    break;
+
+                char name[256];
+                if (!reader.read(name, len))
+                    break;
+
+                names[opcode] = std::string(name, len);
+                continue;
+            }
+            case PACKET_CAPTURE_PACKET:
+            {
+                uint64 msTime;
+                uint8 direction;
+                uint32 socket;
+                uint16 opcode;
+                uint32 length;
+                if (!reader.readUInt64(msTime) || !reader.readUInt8(direction) || !reader.readUInt32(socket) ||
+                    !reader.readUInt16(opcode) || !reader.readUInt32(length))
+                    break;
+
+                data.resize(length);
+                if (length && !reader.read(&data[0], length))
+                    break;
+
+                OpcodeNames::const_iterator itr = names.find(opcode);
+                writePacket(out, msTime, direction, socket, opcode, itr != names.end() ? itr->second.c_str() : "UNKNOWN", data);
+                ++packets;
+                continue;
+            }
+            default:
+                printf("Unknown chunk type %u after %u packets, file damaged\n", chunk, packets);
+                return false;
+        }
+
+        // broken chunk at end of file, server was stopped while writing
+        printf("Truncated chunk after %u packets\n", packets);
+        return true;
+    }
+
+    printf("Converted %u packets\n", packets);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <capture file> <text output file>\n", argv[0]);
+        printf("Convert world packet capture (WorldLogFile) to text packet log\n");
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (!in)
+    {
+        printf("Can't open capture file %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out)
+    {
+        printf("Can't create output file %s\n", argv[2]);
+        fclose(in);
+        return 1;
+    }
+
+    bool result = convert(in, out);
+
+    fclose(out);
+    fclose(in);
+    return result ? 0 : 1;
+}
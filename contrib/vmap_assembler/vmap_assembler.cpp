@@ -1,6 +1,8 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <string>
+#include <vector>
 
 #include "TileAssembler.h"
 
@@ -75,12 +77,41 @@ A '#' at the beginning of a line defines a comment
     }
     return(result);
 } */
+#define MAX_ASSEMBLER_THREADS 64
+
 //=======================================================
 int main(int argc, char* argv[])
 {
+    // optional "--threads <count>" anywhere in the arguments
+    unsigned int threads = 1;
+    std::vector<char*> args;
+    for(int i = 0; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            char* end;
+            long count = strtol(argv[++i], &end, 10);
+            if(*end != '\0' || count < 1)
+            {
+                printf("\ninvalid thread count: %s\n", argv[i]);
+                return 1;
+            }
+            if(count > MAX_ASSEMBLER_THREADS)
+            {
+                printf("thread count %ld limited to %u\n", count, MAX_ASSEMBLER_THREADS);
+                count = MAX_ASSEMBLER_THREADS;
+            }
+            threads = (unsigned int)count;
+        }
+        else
+            args.push_back(argv[i]);
+    }
+    argc = int(args.size());
+    argv = &args[0];
+
     if(argc != 3 && argc != 4)
     {
-        printf("\nusage: %s <raw data dir> <vmap dest dir> [config file name]\n", argv[0]);
+        printf("\nusage: %s <raw data dir> <vmap dest dir> [config file name] [--threads <count>]\n", argv[0]);
         return 1;
     }
 
@@ -92,6 +123,7 @@ int main(int argc, char* argv[])
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(std::string(src), std::string(dest));
     ta->setModelNameFilterMethod(modelNameFilter);
+    ta->setThreadCount(threads);
 
     /*
     All the names in the list are considered to be world maps or huge instances.
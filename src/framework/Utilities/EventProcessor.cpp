@@ -22,6 +22,8 @@ EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_wheel = NULL;
+    m_addCounter = 0;
 }
 
 EventProcessor::~EventProcessor()
@@ -34,13 +36,12 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // main event loop, wheel already moved events of reached time to due list
+    BasicEvent* Event;
+    while (!m_dueEvents.empty() && (Event = m_dueEvents.next->event)->m_execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        RemoveEvent(Event);
 
         if (!Event->to_Abort)
         {
@@ -64,25 +65,19 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (EventListNode* i = m_allEvents.next; i != &m_allEvents;)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* Event = i->event;
+        i = i->next;
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            RemoveEvent(Event);
+            delete Event;
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,10 +86,190 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_addOrder = m_addCounter++;
+    Event->m_owner = this;
+    m_allEvents.link_back(&Event->m_ownerNode);
+
+    // time offset of processor and wheel is kept by updating both with same interval
+    if (m_wheel && e_time > m_time)
+        m_wheel->Schedule(Event, m_wheel->GetScheduleTime(e_time - m_time));
+    else
+        AddDueEvent(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::SetTimerWheel(EventTimerWheel* wheel)
+{
+    if (wheel == m_wheel)
+        return;
+
+    // take back all waiting events
+    if (m_wheel)
+    {
+        for (EventListNode* i = m_allEvents.next; i != &m_allEvents; i = i->next)
+            if (i->event->m_inWheel)
+            {
+                m_wheel->Remove(i->event);
+                AddDueEvent(i->event);
+            }
+    }
+
+    m_wheel = wheel;
+
+    // and give not reached ones to new wheel (due list is sorted, they are at its end)
+    if (m_wheel)
+    {
+        EventListNode waiting;
+        while (!m_dueEvents.empty() && m_dueEvents.prev->event->m_execTime > m_time)
+        {
+            EventListNode* node = m_dueEvents.prev;
+            node->unlink();
+            waiting.next->link_back(node);
+        }
+
+        while (!waiting.empty())
+        {
+            BasicEvent* Event = waiting.next->event;
+            Event->m_queueNode.unlink();
+            m_wheel->Schedule(Event, m_wheel->GetScheduleTime(Event->m_execTime - m_time));
+        }
+    }
+}
+
+void EventProcessor::AddDueEvent(BasicEvent* Event)
+{
+    // usually added at end, events can reach due list from wheel not in adding order
+    EventListNode* i = m_dueEvents.prev;
+    while (i != &m_dueEvents && (i->event->m_execTime > Event->m_execTime ||
+        (i->event->m_execTime == Event->m_execTime && int32(i->event->m_addOrder - Event->m_addOrder) > 0)))
+        i = i->prev;
+
+    i->next->link_back(&Event->m_queueNode);
+}
+
+void EventProcessor::RemoveEvent(BasicEvent* Event)
+{
+    if (Event->m_inWheel)
+        m_wheel->Remove(Event);
+    else
+        Event->m_queueNode.unlink();
+
+    Event->m_ownerNode.unlink();
+    Event->m_owner = NULL;
+}
+
+EventTimerWheel::EventTimerWheel() : m_time(0), m_lastDiff(0), m_count(0)
+{
+}
+
+EventTimerWheel::~EventTimerWheel()
+{
+    // processors still using wheel keep their events in own due lists
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS && m_count; ++level)
+        for (uint32 slot = 0; slot < EVENT_WHEEL_SLOTS && m_count; ++slot)
+            while (!m_slots[level][slot].empty())
+                m_slots[level][slot].next->event->m_owner->SetTimerWheel(NULL);
+
+    while (!m_overflow.empty())
+        m_overflow.next->event->m_owner->SetTimerWheel(NULL);
+}
+
+void EventTimerWheel::Update(uint32 p_time)
+{
+    m_lastDiff = p_time;
+
+    // nothing to cascade or expire, only time is moved
+    if (!m_count)
+    {
+        m_time += p_time;
+        return;
+    }
+
+    for (uint32 tick = 0; tick < p_time; ++tick)
+    {
+        ++m_time;
+
+        // at start of slot of higher level its events are spread into lower levels
+        for (uint32 level = 1; level <= EVENT_WHEEL_LEVELS; ++level)
+        {
+            uint64 levelTime = m_time >> ((level - 1) * EVENT_WHEEL_SLOT_BITS);
+            if (levelTime & (EVENT_WHEEL_SLOTS - 1))
+                break;
+
+            if (level == EVENT_WHEEL_LEVELS)
+                Cascade(m_overflow);
+            else
+                Cascade(m_slots[level][(levelTime >> EVENT_WHEEL_SLOT_BITS) & (EVENT_WHEEL_SLOTS - 1)]);
+        }
+
+        EventListNode& slot = m_slots[0][m_time & (EVENT_WHEEL_SLOTS - 1)];
+        while (!slot.empty())
+        {
+            BasicEvent* Event = slot.next->event;
+            Remove(Event);
+            Event->m_owner->AddDueEvent(Event);
+        }
+    }
+}
+
+void EventTimerWheel::Schedule(BasicEvent* Event, uint64 w_time)
+{
+    // wheel already passed this time, owner checks it at own time
+    if (w_time <= m_time)
+    {
+        Event->m_owner->AddDueEvent(Event);
+        return;
+    }
+
+    Event->m_wheelTime = w_time;
+    Event->m_inWheel = true;
+    ++m_count;
+    Insert(Event);
+}
+
+void EventTimerWheel::Insert(BasicEvent* Event)
+{
+    // lowest level where event is less than one wheel turn ahead, slot of current time was already
+    // cascaded so event must not be a full turn ahead at its level
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        uint64 levelTime = Event->m_wheelTime >> (level * EVENT_WHEEL_SLOT_BITS);
+        if (levelTime - (m_time >> (level * EVENT_WHEEL_SLOT_BITS)) < EVENT_WHEEL_SLOTS)
+        {
+            m_slots[level][levelTime & (EVENT_WHEEL_SLOTS - 1)].link_back(&Event->m_queueNode);
+            return;
+        }
+    }
+
+    m_overflow.link_back(&Event->m_queueNode);
+}
+
+void EventTimerWheel::Remove(BasicEvent* Event)
+{
+    Event->m_queueNode.unlink();
+    Event->m_inWheel = false;
+    --m_count;
+}
+
+void EventTimerWheel::Cascade(EventListNode& slot)
+{
+    // events are reinserted relative to current time, so they go to lower levels (or stay in overflow)
+    EventListNode events;
+    while (!slot.empty())
+    {
+        EventListNode* node = slot.next;
+        node->unlink();
+        events.link_back(node);
+    }
+
+    while (!events.empty())
+    {
+        EventListNode* node = events.next;
+        node->unlink();
+        Insert(node->event);
+    }
+}
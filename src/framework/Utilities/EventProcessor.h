@@ -21,17 +21,49 @@
 
 #include "Platform/Define.h"
 
-#include <map>
-
 // Note. All times are in milliseconds here.
 
+class BasicEvent;
+class EventProcessor;
+class EventTimerWheel;
+
+// node of circular intrusive event list, list head is node without event
+struct EventListNode
+{
+    EventListNode() : prev(this), next(this), event(NULL) {}
+
+    bool empty() const { return next == this; }
+    void link_back(EventListNode* node)                     // add node before this node (at end of list if this is head)
+    {
+        node->prev = prev;
+        node->next = this;
+        prev->next = node;
+        prev = node;
+    }
+    void unlink()
+    {
+        prev->next = next;
+        next->prev = prev;
+        prev = next = this;
+    }
+
+    EventListNode* prev;
+    EventListNode* next;
+    BasicEvent* event;
+};
+
 class BasicEvent
 {
+    friend class EventProcessor;
+    friend class EventTimerWheel;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_owner(NULL), m_wheelTime(0), m_addOrder(0), m_inWheel(false)
         {
+            m_queueNode.event = this;
+            m_ownerNode.event = this;
         }
 
         virtual ~BasicEvent()                               // override destructor to perform some actions on event removal
@@ -53,12 +85,20 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        EventProcessor* m_owner;                            // processor the event was added to
+        EventListNode m_queueNode;                          // in timer wheel slot or in due list of owner
+        EventListNode m_ownerNode;                          // in list of all events of owner
+        uint64 m_wheelTime;                                 // planned time of execution in timer wheel time
+        uint32 m_addOrder;                                  // events of same time are executed in adding order
+        bool m_inWheel;
+};
 
 class EventProcessor
 {
+    friend class EventTimerWheel;
+
     public:
 
         EventProcessor();
@@ -69,11 +109,63 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset);
 
+        // events are waiting in wheel (if set) until their time, detached processor keeps them sorted in due list
+        void SetTimerWheel(EventTimerWheel* wheel);
+
     protected:
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        void AddDueEvent(BasicEvent* Event);                // insert into due list in execution time order
+        void RemoveEvent(BasicEvent* Event);
+
+        EventTimerWheel* m_wheel;
+        uint32 m_addCounter;
+        EventListNode m_dueEvents;                          // events with reached wheel time, executed at owner time
+        EventListNode m_allEvents;
+};
+
+#define EVENT_WHEEL_LEVELS      4
+#define EVENT_WHEEL_SLOT_BITS   6
+#define EVENT_WHEEL_SLOTS       (1 << EVENT_WHEEL_SLOT_BITS)
+
+/**
+ * Hierarchical timer wheel shared by event processors of one container (map).
+ *
+ * Level N slot covers 64^N ms, events are moved to lower level when its slot is reached
+ * (events farther than all levels wait in overflow list), so adding and expiring an event
+ * doesn't depend on count of events. Wheel only moves expired events to due list of their
+ * processor, they are executed in processor Update at processor time as before, so events
+ * of not updated objects still wait.
+ */
+class EventTimerWheel
+{
+    friend class EventProcessor;
+
+    public:
+        EventTimerWheel();
+        ~EventTimerWheel();
+
+        void Update(uint32 p_time);
+        uint64 GetTime() const { return m_time; }
+
+    private:
+        // objects can be updated before or after wheel in same map tick, so events are scheduled
+        // from time of wheel before last update: they may expire early, never late
+        uint64 GetScheduleTime(uint64 offset) const { return m_time - m_lastDiff + offset; }
+
+        void Schedule(BasicEvent* Event, uint64 w_time);
+        void Insert(BasicEvent* Event);                     // by m_wheelTime, not before current time
+        void Remove(BasicEvent* Event);
+        void Cascade(EventListNode& slot);
+
+        uint64 m_time;
+        uint32 m_lastDiff;
+        uint32 m_count;
+        EventListNode m_slots[EVENT_WHEEL_LEVELS][EVENT_WHEEL_SLOTS];
+        EventListNode m_overflow;
 };
 
 #endif
@@ -699,7 +699,8 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    // criteria with other creature, item, spell, ... than miscvalue1 are skipped without lookup
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type, miscvalue1);
     for(AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i!=achievementCriteriaList.end(); ++i)
     {
         AchievementCriteriaEntry const *achievementCriteria = (*i);
@@ -1881,6 +1882,100 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 argument)
+{
+    // login update or type without argument index
+    if (!argument || m_AchievementCriteriasByTypeAndArgument[type].empty())
+        return m_AchievementCriteriasByType[type];
+
+    static AchievementCriteriaEntryList const emptyList;
+
+    AchievementCriteriaListByArgument::const_iterator itr = m_AchievementCriteriasByTypeAndArgument[type].find(argument);
+    return itr != m_AchievementCriteriasByTypeAndArgument[type].end() ? itr->second : emptyList;
+}
+
+/**
+ * argument of criteria compared with miscvalue1 in AchievementMgr::UpdateAchievementCriteria,
+ * only for types where criteria with other argument are skipped without any other check
+ */
+static bool GetAchievementCriteriaArgument(AchievementCriteriaEntry const* criteria, uint32& argument)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+            argument = criteria->kill_creature.creatureID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+            argument = criteria->reach_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            argument = criteria->learn_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+            argument = criteria->complete_quests_in_zone.zoneID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+            argument = criteria->killed_by_creature.creatureEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+            argument = criteria->complete_quest.questID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+            argument = criteria->be_spell_target.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+            argument = criteria->cast_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+            argument = criteria->learn_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+            argument = criteria->loot_type.lootType;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+            argument = criteria->own_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+            argument = criteria->use_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+            argument = criteria->gain_reputation.factionID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
+            argument = criteria->equip_epic_item.itemSlot + 1;  // miscvalue1 = equip_slot+1
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+            argument = criteria->do_emote.emoteID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+            argument = criteria->equip_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+            argument = criteria->use_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            argument = criteria->fish_in_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+            argument = criteria->learn_skillline_spell.skillLine;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            argument = criteria->learn_skill_line.skillLine;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+            argument = criteria->hk_class.classID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+            argument = criteria->hk_race.raceID;
+            return true;
+        default:
+            return false;
+    }
+}
+
 void AchievementGlobalMgr::LoadAchievementCriteriaList()
 {
     if(sAchievementCriteriaStore.GetNumRows()==0)
@@ -1898,6 +1993,10 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
+
+        uint32 argument;
+        if (GetAchievementCriteriaArgument(criteria, argument))
+            m_AchievementCriteriasByTypeAndArgument[criteria->requiredType][argument].push_back(criteria);
     }
 
     sLog.outString(">> Loaded %lu achievement criteria.",(unsigned long)m_AchievementCriteriasByType->size());
@@ -32,6 +32,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef UNORDERED_MAP<uint32,AchievementCriteriaEntryList> AchievementCriteriaListByArgument;
 typedef std::map<uint32,AchievementEntryList>         AchievementListByReferencedId;
 
 struct CriteriaProgress
@@ -275,6 +276,8 @@ class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type);
+        // only criteria with argument (creature, item, spell, ...) for types having one, all criteria of type for 0 argument
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 argument);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id)
         {
             AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -336,6 +339,8 @@ class AchievementGlobalMgr
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // and by their argument for types updated for specific creature, item, spell, ...
+        AchievementCriteriaListByArgument m_AchievementCriteriasByTypeAndArgument[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
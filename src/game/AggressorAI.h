@@ -40,6 +40,7 @@ class DIAMOND_DLL_DECL AggressorAI : public CreatureAI
         void AttackStart(Unit *);
         void EnterEvadeMode();
         bool IsVisible(Unit *) const;
+        uint32 GetLineOfSightInterest() const { return LOS_INTEREST_PLAYERS | LOS_INTEREST_HOSTILE_CREATURES; }
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature *);
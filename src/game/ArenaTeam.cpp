@@ -105,14 +105,12 @@ bool ArenaTeam::AddMember(const uint64& PlayerGuid)
     }
     else
     {
-        //                                                     0     1
-        QueryResult *result = CharacterDatabase.PQuery("SELECT name, class FROM characters WHERE guid='%u'", GUID_LOPART(PlayerGuid));
-        if(!result)
+        PlayerIdentity const* identity = sObjectMgr.GetPlayerIdentity(GUID_LOPART(PlayerGuid));
+        if(!identity)
             return false;
 
-        plName = (*result)[0].GetCppString();
-        plClass = (*result)[1].GetUInt8();
-        delete result;
+        plName = identity->name;
+        plClass = identity->class_;
 
         // check if player already in arenateam of that size
         if(Player::GetArenaTeamIdFromDB(PlayerGuid, GetType()) != 0)
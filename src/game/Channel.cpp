@@ -104,10 +104,7 @@ void Channel::Join(uint64 p, const char *pass)
 
     data.clear();
 
-    PlayerInfo pinfo;
-    pinfo.player = p;
-    pinfo.flags = 0;
-    players[p] = pinfo;
+    AddMember(p, plr);
 
     MakeYouJoined(&data);
     SendToOne(&data, p);
@@ -149,7 +146,7 @@ void Channel::Leave(uint64 p, bool send)
 
         bool changeowner = players[p].IsOwner();
 
-        players.erase(p);
+        RemoveMember(p);
         if(m_announce && (!plr || plr->GetSession()->GetSecurity() < SEC_GAMEMASTER || !sWorld.getConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL) ))
         {
             WorldPacket data;
@@ -216,7 +213,7 @@ void Channel::KickOrBan(uint64 good, const char *badname, bool ban)
                 MakePlayerKicked(&data, bad->GetGUID(), good);
 
             SendToAll(&data);
-            players.erase(bad->GetGUID());
+            RemoveMember(bad->GetGUID());
             bad->LeftChannel(this);
 
             if(changeowner)
@@ -661,30 +658,57 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket *data, uint64 p)
+void Channel::AddMember(uint64 guid, Player* plr)
 {
-    for(PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    PlayerInfo pinfo;
+    pinfo.player = guid;
+
+    if(plr)
     {
-        Player *plr = sObjectMgr.GetPlayer(i->first);
-        if(plr)
-        {
-            if(!p || !plr->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                plr->GetSession()->SendPacket(data);
-        }
+        pinfo.slot = m_online.size();
+        m_online.push_back(plr);
     }
+
+    players[guid] = pinfo;
 }
 
-void Channel::SendToAllButOne(WorldPacket *data, uint64 who)
+void Channel::RemoveMember(uint64 guid)
 {
-    for(PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    PlayerList::iterator itr = players.find(guid);
+    if(itr == players.end())
+        return;
+
+    // move last online member to freed slot
+    uint32 slot = itr->second.slot;
+    if(slot != CHANNEL_NO_SLOT)
     {
-        if(i->first != who)
+        Player* last = m_online.back();
+        m_online[slot] = last;
+        m_online.pop_back();
+
+        if(last->GetGUID() != guid)
         {
-            Player *plr = sObjectMgr.GetPlayer(i->first);
-            if(plr)
-                plr->GetSession()->SendPacket(data);
+            PlayerList::iterator lastItr = players.find(last->GetGUID());
+            if(lastItr != players.end())
+                lastItr->second.slot = slot;
         }
     }
+
+    players.erase(itr);
+}
+
+void Channel::SendToAll(WorldPacket *data, uint64 p)
+{
+    for(OnlineList::const_iterator i = m_online.begin(); i != m_online.end(); ++i)
+        if(!p || !(*i)->GetSocial()->HasIgnore(GUID_LOPART(p)))
+            (*i)->GetSession()->SendPacket(data);
+}
+
+void Channel::SendToAllButOne(WorldPacket *data, uint64 who)
+{
+    for(OnlineList::const_iterator i = m_online.begin(); i != m_online.end(); ++i)
+        if((*i)->GetGUID() != who)
+            (*i)->GetSession()->SendPacket(data);
 }
 
 void Channel::SendToOne(WorldPacket *data, uint64 who)
@@ -71,6 +71,8 @@ enum ChatNotify
     // 0x24 enable voice?
 };
 
+#define CHANNEL_NO_SLOT 0xFFFFFFFF
+
 class Channel
 {
     enum ChannelFlags
@@ -120,8 +122,11 @@ class Channel
 
     struct PlayerInfo
     {
+        PlayerInfo() : player(0), flags(0), slot(CHANNEL_NO_SLOT) {}
+
         uint64 player;
         uint8 flags;
+        uint32 slot;                                        // index in m_online, CHANNEL_NO_SLOT if joined offline
 
         bool HasFlag(uint8 flag) { return flags & flag; }
         void SetFlag(uint8 flag) { if(!HasFlag(flag)) flags |= flag; }
@@ -147,6 +152,9 @@ class Channel
 
     typedef     std::map<uint64, PlayerInfo> PlayerList;
     PlayerList  players;
+    // online members for packet fan out, removed at leave/kick and at logout (Player::CleanupChannels)
+    typedef     std::vector<Player*> OnlineList;
+    OnlineList  m_online;
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     bool        m_announce;
@@ -158,6 +166,9 @@ class Channel
     uint64      m_ownerGUID;
 
     private:
+        void AddMember(uint64 guid, Player* plr);
+        void RemoveMember(uint64 guid);
+
         // initial packet data (notify type and channel name)
         void MakeNotifyPacket(WorldPacket *data, uint8 notify_type);
         // type specific packet data
@@ -452,6 +452,7 @@ class ChatHandler
         bool HandleServerLogFilterCommand(const char* args);
         bool HandleServerLogLevelCommand(const char* args);
         bool HandleServerMotdCommand(const char* args);
+        bool HandleServerOpcodeStatsCommand(const char* args);
         bool HandleServerPLimitCommand(const char* args);
         bool HandleServerRestartCommand(const char* args);
         bool HandleServerSetMotdCommand(const char* args);
@@ -118,7 +118,7 @@ m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE), m_DBTableGuid(0), m
 m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false),
 m_regenHealth(true), m_AI_locked(false), m_isDeadByDefault(false), m_needNotify(false),
 m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
-m_creatureInfo(NULL), m_isActiveObject(false), m_splineFlags(SPLINEFLAG_WALKMODE)
+m_creatureInfo(NULL), m_isActiveObject(false), m_splineFlags(SPLINEFLAG_WALKMODE), m_entryIndexKey(0)
 {
     m_regenTimer = 200;
     m_valuesCount = UNIT_END;
@@ -147,7 +147,10 @@ void Creature::AddToWorld()
 {
     ///- Register the creature for guid lookup
     if(!IsInWorld() && GetObjectGuid().GetHigh() == HIGHGUID_UNIT)
+    {
         GetMap()->GetObjectsStore().insert<Creature>(GetGUID(), (Creature*)this);
+        GetMap()->GetCreatureEntryIndex().Insert(this);
+    }
 
     Unit::AddToWorld();
 }
@@ -156,7 +159,10 @@ void Creature::RemoveFromWorld()
 {
     ///- Remove the creature from the accessor
     if(IsInWorld() && GetObjectGuid().GetHigh() == HIGHGUID_UNIT)
+    {
         GetMap()->GetObjectsStore().erase<Creature>(GetGUID(), (Creature*)NULL);
+        GetMap()->GetCreatureEntryIndex().Remove(this);
+    }
 
     Unit::RemoveFromWorld();
 }
@@ -220,6 +226,10 @@ bool Creature::InitEntry(uint32 Entry, uint32 team, const CreatureData *data )
     }
 
     SetEntry(Entry);                                        // normal entry always
+
+    // entry index of map is keyed by normal entry
+    if (IsInWorld())
+        GetMap()->GetCreatureEntryIndex().UpdateEntry(this);
     m_creatureInfo = cinfo;                                 // map mode related always
 
     // equal to player Race field, but creature does not have race
@@ -2267,7 +2277,7 @@ void Creature::SendAreaSpiritHealerQueryOpcode(Player *pl)
 
 void Creature::RelocationNotify()
 {
-    Diamond::CreatureRelocationNotifier relocationNotifier(*this);
     float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+    Diamond::CreatureRelocationNotifier relocationNotifier(*this, radius);
     Cell::VisitAllObjects(this, relocationNotifier, radius);
 }
@@ -33,6 +33,7 @@
 struct SpellEntry;
 
 class CreatureAI;
+template<class T> class MapEntryIndex;
 class Group;
 class Quest;
 class Player;
@@ -709,6 +710,10 @@ class DIAMOND_DLL_SPEC Creature : public Unit
         CreatureInfo const* m_creatureInfo;                 // in difficulty mode > 0 can different from ObjMgr::GetCreatureTemplate(GetEntry())
         bool m_isActiveObject;
         SplineFlags m_splineFlags;
+
+        // entry the creature is listed under in map entry index, 0 if not listed
+        friend class MapEntryIndex<Creature>;
+        uint32 m_entryIndexKey;
 };
 
 class AssistDelayEvent : public BasicEvent
@@ -56,6 +56,17 @@ enum CastFlags
     CAST_AURA_NOT_PRESENT       = 0x20,                     //Only casts the spell if the target does not have an aura from the spell
 };
 
+// Units for which relocation notifiers call MoveInLineOfSight
+enum LineOfSightInterest
+{
+    LOS_INTEREST_NONE               = 0x00,
+    LOS_INTEREST_PLAYERS            = 0x01,
+    LOS_INTEREST_HOSTILE_CREATURES  = 0x02,                 // creatures hostile to AI creature
+    LOS_INTEREST_OTHER_CREATURES    = 0x04,                 // not hostile creatures
+    LOS_INTEREST_CREATURES          = LOS_INTEREST_HOSTILE_CREATURES | LOS_INTEREST_OTHER_CREATURES,
+    LOS_INTEREST_ALL                = LOS_INTEREST_PLAYERS | LOS_INTEREST_CREATURES
+};
+
 class DIAMOND_DLL_SPEC CreatureAI
 {
     public:
@@ -142,6 +153,9 @@ class DIAMOND_DLL_SPEC CreatureAI
         // Is unit visible for MoveInLineOfSight
         virtual bool IsVisible(Unit *) const { return false; }
 
+        // Kinds of units MoveInLineOfSight reacts to (LineOfSightInterest mask), others are skipped before IsVisible
+        virtual uint32 GetLineOfSightInterest() const { return LOS_INTEREST_ALL; }
+
         // called when the corpse of this creature gets removed
         virtual void CorpseRemoved(uint32 & /*respawnDelay*/) {}
 
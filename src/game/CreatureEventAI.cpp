@@ -86,6 +86,14 @@ CreatureEventAI::CreatureEventAI(Creature *c ) : CreatureAI(c)
         sLog.outError("CreatureEventAI: EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
 
     bEmptyList = CreatureEventAIList.empty();
+
+    LineOfSightInterestMask = LOS_INTEREST_PLAYERS | LOS_INTEREST_HOSTILE_CREATURES;
+    for (std::list<CreatureEventAIHolder>::const_iterator i = CreatureEventAIList.begin(); i != CreatureEventAIList.end(); ++i)
+    {
+        if ((*i).Event.event_type == EVENT_T_OOC_LOS && (*i).Event.ooc_los.noHostile)
+            LineOfSightInterestMask |= LOS_INTEREST_OTHER_CREATURES;
+    }
+
     Phase = 0;
     CombatMovementEnabled = true;
     MeleeEnabled = true;
@@ -585,6 +585,7 @@ class DIAMOND_DLL_SPEC CreatureEventAI : public CreatureAI
         void DamageTaken(Unit* done_by, uint32& damage);
         void UpdateAI(const uint32 diff);
         bool IsVisible(Unit *) const;
+        uint32 GetLineOfSightInterest() const { return LineOfSightInterestMask; }
         void ReceiveEmote(Player* pPlayer, uint32 text_emote);
         void SummonedCreatureJustDied(Creature* unit);
         void SummonedCreatureDespawn(Creature* unit);
@@ -612,6 +613,7 @@ class DIAMOND_DLL_SPEC CreatureEventAI : public CreatureAI
         uint32 EventUpdateTime;                             //Time between event updates
         uint32 EventDiff;                                   //Time between the last event call
         bool bEmptyList;
+        uint32 LineOfSightInterestMask;                     // not hostile creatures only for friendly OOC LOS events
 
         //Variables used by Events themselves
         uint8 Phase;                                        // Current phase, max 32 phases
@@ -57,6 +57,7 @@ GameObject::GameObject() : WorldObject()
 
     m_DBTableGuid = 0;
     m_rotation = 0;
+    m_entryIndexKey = 0;
 }
 
 GameObject::~GameObject()
@@ -67,7 +68,10 @@ void GameObject::AddToWorld()
 {
     ///- Register the gameobject for guid lookup
     if(!IsInWorld())
+    {
         GetMap()->GetObjectsStore().insert<GameObject>(GetGUID(), (GameObject*)this);
+        GetMap()->GetGameObjectEntryIndex().Insert(this);
+    }
 
     Object::AddToWorld();
 }
@@ -91,6 +95,7 @@ void GameObject::RemoveFromWorld()
         }
 
         GetMap()->GetObjectsStore().erase<GameObject>(GetGUID(), (GameObject*)NULL);
+        GetMap()->GetGameObjectEntryIndex().Remove(this);
     }
 
     Object::RemoveFromWorld();
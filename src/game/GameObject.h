@@ -572,6 +572,7 @@ enum LootState
 };
 
 class Unit;
+template<class T> class MapEntryIndex;
 
 // 5 sec for bobber catch
 #define FISHING_BOBBER_READY_TIME 5
@@ -727,5 +728,9 @@ class DIAMOND_DLL_SPEC GameObject : public WorldObject
         void SwitchDoorOrButton(bool activate, bool alternative = false);
 
         GridReference<GameObject> m_gridRef;
+
+        // entry the gameobject is listed under in map entry index, 0 if not listed
+        friend class MapEntryIndex<GameObject>;
+        uint32 m_entryIndexKey;
 };
 #endif
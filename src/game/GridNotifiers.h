@@ -157,7 +157,8 @@ namespace Diamond
     struct DIAMOND_DLL_DECL CreatureRelocationNotifier
     {
         Creature &i_creature;
-        CreatureRelocationNotifier(Creature &c) : i_creature(c) {}
+        float i_radius;                                     // creature pairs farther apart not notified
+        CreatureRelocationNotifier(Creature &c, float radius) : i_creature(c), i_radius(radius) {}
         template<class T> void Visit(GridRefManager<T> &) {}
         #ifdef WIN32
         template<> void Visit(PlayerMapType &);
@@ -69,22 +69,35 @@ inline void PlayerCreatureRelocationWorker(Player* pl, WorldObject const* viewPo
     // Creature AI reaction
     if (!c->hasUnitState(UNIT_STAT_FLEEING))
     {
-        if (c->AI() && c->AI()->IsVisible(pl) && !c->IsInEvadeMode())
+        if (c->AI() && (c->AI()->GetLineOfSightInterest() & LOS_INTEREST_PLAYERS) &&
+            c->AI()->IsVisible(pl) && !c->IsInEvadeMode())
             c->AI()->MoveInLineOfSight(pl);
     }
 }
 
+inline bool IsLineOfSightInterestedIn(Creature* c, Creature* who)
+{
+    uint32 interest = c->AI()->GetLineOfSightInterest() & LOS_INTEREST_CREATURES;
+    if (interest == LOS_INTEREST_CREATURES)
+        return true;
+
+    if (interest == LOS_INTEREST_NONE)
+        return false;
+
+    return c->IsHostileTo(who) == ((interest & LOS_INTEREST_HOSTILE_CREATURES) != 0);
+}
+
 inline void CreatureCreatureRelocationWorker(Creature* c1, Creature* c2)
 {
     if (!c1->hasUnitState(UNIT_STAT_FLEEING))
     {
-        if (c1->AI() && c1->AI()->IsVisible(c2) && !c1->IsInEvadeMode())
+        if (c1->AI() && IsLineOfSightInterestedIn(c1, c2) && c1->AI()->IsVisible(c2) && !c1->IsInEvadeMode())
             c1->AI()->MoveInLineOfSight(c2);
     }
 
     if (!c2->hasUnitState(UNIT_STAT_FLEEING))
     {
-        if (c2->AI() && c2->AI()->IsVisible(c1) && !c2->IsInEvadeMode())
+        if (c2->AI() && IsLineOfSightInterestedIn(c2, c1) && c2->AI()->IsVisible(c1) && !c2->IsInEvadeMode())
             c2->AI()->MoveInLineOfSight(c1);
     }
 }
@@ -122,7 +135,7 @@ inline void Diamond::CreatureRelocationNotifier::Visit(CreatureMapType &m)
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c != &i_creature && c->isAlive())
+        if (c != &i_creature && c->isAlive() && c->IsWithinDist(&i_creature, i_radius, false))
             CreatureCreatureRelocationWorker(c, &i_creature);
     }
 }
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "GridPreloader.h"
+#include "GridMap.h"
+#include "Timer.h"
+#include "VMapFactory.h"
+#include <ace/Guard_T.h>
+
+#define GRID_PRELOADER_IDLE_SLEEP   10                      // ms between polls of empty queue
+#define GRID_PRELOADER_READY_TIME   (60*IN_MILLISECONDS)    // not taken grids dropped after this time
+
+GridPreloader::GridPreloader(std::string const& dataPath, uint32 maxQueued) :
+    m_dataPath(dataPath), m_maxQueued(maxQueued), m_running(true)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    for (ReadyMap::iterator itr = m_ready.begin(); itr != m_ready.end(); ++itr)
+        DeleteGrid(itr->second);
+}
+
+void GridPreloader::Request(uint32 mapId, int gx, int gy, bool vmap, bool navMesh)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    // loader behind: skip, grid will be loaded at enter as without preloading
+    if (m_queue.size() >= m_maxQueued || !m_requested.insert(key).second)
+        return;
+
+    PreloadRequest req;
+    req.key = key;
+    req.vmap = vmap;
+    req.navMesh = navMesh;
+    m_queue.push_back(req);
+}
+
+bool GridPreloader::Take(uint32 mapId, int gx, int gy, PreloadedGrid& grid)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    ReadyMap::iterator itr = m_ready.find(key);
+    if (itr == m_ready.end())
+        return false;
+
+    grid = itr->second;
+    m_ready.erase(itr);
+    m_requested.erase(key);
+    return true;
+}
+
+void GridPreloader::Load(PreloadRequest const& req, PreloadedGrid& grid)
+{
+    uint32 mapId = req.key >> 12;
+    int gx = int((req.key >> 6) & 0x3F);
+    int gy = int(req.key & 0x3F);
+
+    char fileName[512];
+
+    snprintf(fileName, sizeof(fileName), "%smaps/%03u%02u%02u.map", m_dataPath.c_str(), mapId, gx, gy);
+    grid.gridMap = new GridMap();
+    if (!grid.gridMap->loadData(fileName))
+    {
+        // map thread will try again and report error
+        delete grid.gridMap;
+        grid.gridMap = NULL;
+    }
+
+    if (req.vmap)
+        VMAP::VMapFactory::createOrGetVMapManager()->preloadMapFiles((m_dataPath + "vmaps").c_str(), mapId, gx, gy);
+
+    if (req.navMesh)
+    {
+        snprintf(fileName, sizeof(fileName), "%smmaps/%03u%02i%02i.mmtile", m_dataPath.c_str(), mapId, gx, gy);
+        if (FILE* file = fopen(fileName, "rb"))
+        {
+            fseek(file, 0, SEEK_END);
+            int length = ftell(file);
+            fseek(file, 0, SEEK_SET);
+
+            if (length > 0)
+            {
+                grid.navMeshTile = new unsigned char[length];
+                if (fread(grid.navMeshTile, length, 1, file) == 1)
+                    grid.navMeshTileLength = length;
+                else
+                {
+                    delete [] grid.navMeshTile;
+                    grid.navMeshTile = NULL;
+                }
+            }
+            fclose(file);
+        }
+    }
+}
+
+void GridPreloader::ExpireReady(uint32 now)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    for (ReadyMap::iterator itr = m_ready.begin(); itr != m_ready.end();)
+    {
+        if (getMSTimeDiff(itr->second.readyTime, now) >= GRID_PRELOADER_READY_TIME)
+        {
+            DeleteGrid(itr->second);
+            m_requested.erase(itr->first);
+            m_ready.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+void GridPreloader::DeleteGrid(PreloadedGrid& grid)
+{
+    delete grid.gridMap;
+    delete [] grid.navMeshTile;
+    grid.gridMap = NULL;
+    grid.navMeshTile = NULL;
+}
+
+void GridPreloader::run()
+{
+    uint32 lastExpire = getMSTime();
+
+    while (m_running)
+    {
+        PreloadRequest req;
+        bool found = false;
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+            if (!m_queue.empty())
+            {
+                req = m_queue.front();
+                m_queue.pop_front();
+                found = true;
+            }
+        }
+
+        uint32 now = getMSTime();
+        if (getMSTimeDiff(lastExpire, now) >= IN_MILLISECONDS)
+        {
+            ExpireReady(now);
+            lastExpire = now;
+        }
+
+        if (!found)
+        {
+            ACE_Based::Thread::Sleep(GRID_PRELOADER_IDLE_SLEEP);
+            continue;
+        }
+
+        // files are read without lock, map thread can request and take meantime
+        PreloadedGrid grid;
+        Load(req, grid);
+        grid.readyTime = getMSTime();
+
+        ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+        m_ready[req.key] = grid;
+    }
+}
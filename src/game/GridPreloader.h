@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_GRIDPRELOADER_H
+#define DIAMOND_GRIDPRELOADER_H
+
+#include "Common.h"
+#include "Threading.h"
+#include <ace/Thread_Mutex.h>
+#include <deque>
+#include <set>
+#include <map>
+
+class GridMap;
+
+/// Terrain data of one grid read by preloader thread, owned by caller after GridPreloader::Take
+struct PreloadedGrid
+{
+    PreloadedGrid() : gridMap(NULL), navMeshTile(NULL), navMeshTileLength(0), readyTime(0) {}
+
+    GridMap* gridMap;                                       ///< NULL if map file not loaded
+    unsigned char* navMeshTile;                             ///< raw mmtile file, NULL if not exist
+    int navMeshTileLength;
+    uint32 readyTime;
+};
+
+/**
+ * Background thread reading terrain files of grids players are moving to.
+ *
+ * Map thread requests grids (in GridMap file coordinates) ahead of moving players,
+ * preloader builds GridMap and reads mmtile data, so at grid load the map only
+ * puts them in place instead of reading files. VMapManager is not thread safe,
+ * so for vmaps the tile and model files are only read to have them in OS file cache.
+ * Not taken grids are dropped after some time.
+ */
+class GridPreloader : public ACE_Based::Runnable
+{
+    public:
+        GridPreloader(std::string const& dataPath, uint32 maxQueued);
+        ~GridPreloader();
+
+        ///< Map thread: queue grid if not queued or ready already
+        void Request(uint32 mapId, int gx, int gy, bool vmap, bool navMesh);
+        ///< Map thread: false if grid not ready (not requested or still loading)
+        bool Take(uint32 mapId, int gx, int gy, PreloadedGrid& grid);
+
+        void Stop() { m_running = false; }                  ///< Stop event
+        virtual void run();                                 ///< Main Thread loop
+
+    private:
+        struct PreloadRequest
+        {
+            uint32 key;
+            bool vmap;
+            bool navMesh;
+        };
+
+        typedef std::deque<PreloadRequest> RequestQueue;
+        typedef std::set<uint32> KeySet;
+        typedef std::map<uint32, PreloadedGrid> ReadyMap;
+
+        static uint32 MakeKey(uint32 mapId, int gx, int gy) { return (mapId << 12) | (uint32(gx) << 6) | uint32(gy); }
+
+        void Load(PreloadRequest const& req, PreloadedGrid& grid);
+        void ExpireReady(uint32 now);
+        static void DeleteGrid(PreloadedGrid& grid);
+
+        std::string m_dataPath;
+        uint32 m_maxQueued;
+
+        ACE_Thread_Mutex m_lock;                            ///< guards containers below
+        RequestQueue m_queue;
+        KeySet m_requested;                                 ///< queued, loading or ready
+        ReadyMap m_ready;
+
+        volatile bool m_running;
+};
+#endif
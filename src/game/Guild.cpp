@@ -50,6 +50,8 @@ Guild::Guild()
     m_GuildBankEventLogNextGuid_Money = 0;
     for (uint8 i = 0; i < GUILD_BANK_MAX_TABS; ++i)
         m_GuildBankEventLogNextGuid_Item[i] = 0;
+
+    m_rosterValid = false;
 }
 
 Guild::~Guild()
@@ -168,6 +170,7 @@ bool Guild::AddMember(uint64 plGuid, uint32 plRank)
     for (int i = 0; i < GUILD_BANK_MAX_TABS; ++i)
         newmember.BankResetTimeTab[i] = 0;
     members[GUID_LOPART(plGuid)] = newmember;
+    m_rosterValid = false;
 
     std::string dbPnote   = newmember.Pnote;
     std::string dbOFFnote = newmember.OFFnote;
@@ -190,6 +193,7 @@ bool Guild::AddMember(uint64 plGuid, uint32 plRank)
 void Guild::SetMOTD(std::string motd)
 {
     MOTD = motd;
+    m_rosterValid = false;
 
     // motd now can be used for encoding to DB
     CharacterDatabase.escape_string(motd);
@@ -199,6 +203,7 @@ void Guild::SetMOTD(std::string motd)
 void Guild::SetGINFO(std::string ginfo)
 {
     GINFO = ginfo;
+    m_rosterValid = false;
 
     // ginfo now can be used for encoding to DB
     CharacterDatabase.escape_string(ginfo);
@@ -427,6 +432,7 @@ void Guild::SetMemberStats(uint64 guid)
     itr->second.Level  = pl->getLevel();
     itr->second.Class  = pl->getClass();
     itr->second.ZoneId = pl->GetZoneId();
+    m_rosterValid = false;
 }
 
 void Guild::SetLeader(uint64 guid)
@@ -482,6 +488,7 @@ void Guild::DelMember(uint64 guid, bool isDisbanding)
     }
 
     members.erase(GUID_LOPART(guid));
+    m_rosterValid = false;
 
     Player *player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -499,6 +506,7 @@ void Guild::ChangeRank(uint64 guid, uint32 newRank)
     MemberList::iterator itr = members.find(GUID_LOPART(guid));
     if (itr != members.end())
         itr->second.RankId = newRank;
+    m_rosterValid = false;
 
     Player *player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -515,6 +523,7 @@ void Guild::SetPNOTE(uint64 guid,std::string pnote)
         return;
 
     itr->second.Pnote = pnote;
+    m_rosterValid = false;
 
     // pnote now can be used for encoding to DB
     CharacterDatabase.escape_string(pnote);
@@ -527,6 +536,7 @@ void Guild::SetOFFNOTE(uint64 guid,std::string offnote)
     if (itr == members.end())
         return;
     itr->second.OFFnote = offnote;
+    m_rosterValid = false;
     // offnote now can be used for encoding to DB
     CharacterDatabase.escape_string(offnote);
     CharacterDatabase.PExecute("UPDATE guild_member SET offnote = '%s' WHERE guid = '%u'", offnote.c_str(), itr->first);
@@ -614,6 +624,7 @@ void Guild::CreateRank(std::string name_,uint32 rights)
 void Guild::AddRank(const std::string& name_,uint32 rights, uint32 money)
 {
     m_Ranks.push_back(RankInfo(name_,rights,money));
+    m_rosterValid = false;
 }
 
 void Guild::DelRank()
@@ -628,6 +639,7 @@ void Guild::DelRank()
     CharacterDatabase.PExecute("DELETE FROM guild_bank_right WHERE rid>='%u' AND guildid='%u'", rank, m_Id);
 
     m_Ranks.pop_back();
+    m_rosterValid = false;
 }
 
 std::string Guild::GetRankName(uint32 rankId)
@@ -664,6 +676,7 @@ void Guild::SetRankRights(uint32 rankId, uint32 rights)
         return;
 
     m_Ranks[rankId].Rights = rights;
+    m_rosterValid = false;
 
     CharacterDatabase.PExecute("UPDATE guild_rank SET rights='%u' WHERE rid='%u' AND guildid='%u'", rights, rankId, m_Id);
 }
@@ -700,10 +713,13 @@ void Guild::Disband()
     sObjectMgr.RemoveGuild(m_Id);
 }
 
-void Guild::Roster(WorldSession *session /*= NULL*/)
+void Guild::BuildRoster()
 {
+    m_rosterOnline.clear();
+    m_rosterOffline.clear();
                                                             // we can only guess size
-    WorldPacket data(SMSG_GUILD_ROSTER, (4+MOTD.length()+1+GINFO.length()+1+4+m_Ranks.size()*(4+4+GUILD_BANK_MAX_TABS*(4+4))+members.size()*50));
+    WorldPacket& data = m_roster;
+    data.Initialize(SMSG_GUILD_ROSTER, (4+MOTD.length()+1+GINFO.length()+1+4+m_Ranks.size()*(4+4+GUILD_BANK_MAX_TABS*(4+4))+members.size()*50));
     data << uint32(members.size());
     data << MOTD;
     data << GINFO;
@@ -721,15 +737,20 @@ void Guild::Roster(WorldSession *session /*= NULL*/)
     }
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
-        if (Player *pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
+        // logged in members are online also while not in world (far teleport), zone is patched after
+        if (Player *pl = HashMapHolder<Player>::Find(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
         {
+            RosterMemberPos& pos = m_rosterOnline[itr->first];
+
             data << uint64(pl->GetGUID());
             data << uint8(1);
             data << pl->GetName();
             data << uint32(itr->second.RankId);
+            pos.level = data.wpos();
             data << uint8(pl->getLevel());
             data << uint8(pl->getClass());
             data << uint8(0);                               // new 2.4.0
+            pos.zone = data.wpos();
             data << uint32(pl->GetZoneId());
             data << itr->second.Pnote;
             data << itr->second.OFFnote;
@@ -744,18 +765,53 @@ void Guild::Roster(WorldSession *session /*= NULL*/)
             data << uint8(itr->second.Class);
             data << uint8(0);                               // new 2.4.0
             data << uint32(itr->second.ZoneId);
-            data << float(float(time(NULL)-itr->second.LogoutTime) / DAY);
+            m_rosterOffline.push_back(RosterLogoutPos(data.wpos(), itr->second.LogoutTime));
+            data << float(0.0f);                            // days since logout, set at send
             data << itr->second.Pnote;
             data << itr->second.OFFnote;
         }
     }
+
+    m_rosterValid = true;
+}
+
+void Guild::Roster(WorldSession *session /*= NULL*/)
+{
+    // roster rebuilt only after member, rank or note changes, online members level and zone are patched in place
+    if (!m_rosterValid)
+        BuildRoster();
+
+    time_t now = time(NULL);
+    for (RosterLogoutPosList::const_iterator itr = m_rosterOffline.begin(); itr != m_rosterOffline.end(); ++itr)
+        m_roster.put<float>(itr->first, float(now - itr->second) / DAY);
+
     if (session)
-        session->SendPacket(&data);
+        session->SendPacket(&m_roster);
     else
-        BroadcastPacket(&data);
+        BroadcastPacket(&m_roster);
     DEBUG_LOG( "WORLD: Sent (SMSG_GUILD_ROSTER)" );
 }
 
+void Guild::UpdateRosterMemberLevel(uint32 lowguid, uint8 level)
+{
+    if (!m_rosterValid)
+        return;
+
+    RosterMemberPosMap::const_iterator itr = m_rosterOnline.find(lowguid);
+    if (itr != m_rosterOnline.end())
+        m_roster.put<uint8>(itr->second.level, level);
+}
+
+void Guild::UpdateRosterMemberZone(uint32 lowguid, uint32 zoneId)
+{
+    if (!m_rosterValid)
+        return;
+
+    RosterMemberPosMap::const_iterator itr = m_rosterOnline.find(lowguid);
+    if (itr != m_rosterOnline.end())
+        m_roster.put<uint32>(itr->second.zone, zoneId);
+}
+
 void Guild::Query(WorldSession *session)
 {
     WorldPacket data(SMSG_GUILD_QUERY_RESPONSE, (8*32+200));// we can only guess size
@@ -800,6 +856,7 @@ void Guild::UpdateLogoutTime(uint64 guid)
         return;
 
     itr->second.LogoutTime = time(NULL);
+    m_rosterValid = false;
 }
 
 // *************************************************
@@ -1297,6 +1354,7 @@ void Guild::SetBankMoneyPerDay(uint32 rankId, uint32 money)
         money = WITHDRAW_MONEY_UNLIMITED;
 
     m_Ranks[rankId].BankMoneyPerDay = money;
+    m_rosterValid = false;
 
     for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
         if (itr->second.RankId == rankId)
@@ -1325,6 +1383,7 @@ void Guild::SetBankRightsAndSlots(uint32 rankId, uint8 TabId, uint32 right, uint
 
     m_Ranks[rankId].TabSlotPerDay[TabId] = nbSlots;
     m_Ranks[rankId].TabRight[TabId] = right;
+    m_rosterValid = false;
 
     if (db)
     {
@@ -24,6 +24,7 @@
 
 #include "Common.h"
 #include "Item.h"
+#include "WorldPacket.h"
 
 class Item;
 
@@ -377,6 +378,9 @@ class Guild
         }
 
         void Roster(WorldSession *session = NULL);          // NULL = broadcast
+        void InvalidateRoster() { m_rosterValid = false; }  // online state of member changed
+        void UpdateRosterMemberLevel(uint32 lowguid, uint8 level);
+        void UpdateRosterMemberZone(uint32 lowguid, uint32 zoneId);
         void Query(WorldSession *session);
 
         void   UpdateLogoutTime(uint64 guid);
@@ -465,6 +469,8 @@ class Guild
         uint8 m_PurchasedTabs;
 
     private:
+        void BuildRoster();
+
         // used only from high level Swap/Move functions
         Item*  GetItem(uint8 TabId, uint8 SlotId);
         uint8  CanStoreItem( uint8 tab, uint8 slot, GuildItemPosCountVec& dest, uint32 count, Item *pItem, bool swap = false) const;
@@ -478,5 +484,20 @@ class Guild
         uint8 _CanStoreItem_InSpecificSlot( uint8 tab, uint8 slot, GuildItemPosCountVec& dest, uint32& count, bool swap, Item *pSrcItem ) const;
         uint8 _CanStoreItem_InTab( uint8 tab, GuildItemPosCountVec& dest, uint32& count, bool merge, Item *pSrcItem, uint8 skip_slot ) const;
         Item* _StoreItem( uint8 tab, uint8 slot, Item *pItem, uint32 count, bool clone );
+
+        // cached SMSG_GUILD_ROSTER with byte positions of fields changed without rebuild
+        struct RosterMemberPos
+        {
+            size_t level;
+            size_t zone;
+        };
+        typedef std::map<uint32, RosterMemberPos> RosterMemberPosMap;
+        typedef std::pair<size_t, uint64> RosterLogoutPos;  // days since logout position, logout time
+        typedef std::vector<RosterLogoutPos> RosterLogoutPosList;
+
+        WorldPacket m_roster;
+        bool m_rosterValid;
+        RosterMemberPosMap m_rosterOnline;
+        RosterLogoutPosList m_rosterOffline;
 };
 #endif
@@ -4508,6 +4508,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, uint64 player_guid, uint3
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, GUID_LOPART(player_guid));
+        sObjectMgr.SetPlayerIdentityLevel(GUID_LOPART(player_guid), newlevel);
     }
 }
 
@@ -6244,6 +6245,52 @@ bool ChatHandler::HandleServerPLimitCommand(const char *args)
     return true;
 }
 
+static bool OpcodeTotalTimeOrder(uint16 a, uint16 b)
+{
+    return opcodeStatistics[a].totalTime > opcodeStatistics[b].totalTime;
+}
+
+bool ChatHandler::HandleServerOpcodeStatsCommand(const char *args)
+{
+    uint32 count = 20;
+    if(*args)
+    {
+        char* param = strtok((char*)args, " ");
+        if(!param)
+            return false;
+
+        if(strncmp(param, "reset", strlen(param)) == 0)
+        {
+            memset(opcodeStatistics, 0, sizeof(opcodeStatistics));
+            PSendSysMessage("Opcode statistics reset.");
+            return true;
+        }
+
+        count = atoi(param);
+        if(!count)
+            return false;
+    }
+
+    std::vector<uint16> opcodes;
+    for(uint16 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+        if(opcodeStatistics[opcode].count)
+            opcodes.push_back(opcode);
+
+    std::sort(opcodes.begin(), opcodes.end(), OpcodeTotalTimeOrder);
+    if(opcodes.size() > count)
+        opcodes.resize(count);
+
+    PSendSysMessage("Received opcodes by handler time (calls, total ms, avg us, max us):");
+    for(std::vector<uint16>::const_iterator itr = opcodes.begin(); itr != opcodes.end(); ++itr)
+    {
+        OpcodeStatistics const& stats = opcodeStatistics[*itr];
+        PSendSysMessage("%s (0x%.4X): " UI64FMTD ", " UI64FMTD ", " UI64FMTD ", %u", LookupOpcodeName(*itr), *itr,
+            stats.count, stats.totalTime / 1000, stats.totalTime / stats.count, stats.maxTime);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(const char* args)
 {
     if(!*args)
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LoginQueue.h"
+
+#define LOGIN_QUEUE_MIN_CAPACITY 64
+
+LoginQueue::LoginQueue() : m_head(0), m_count(0), m_changedFrom(0), m_changed(false)
+{
+    m_tree.resize(LOGIN_QUEUE_MIN_CAPACITY + 1, 0);
+}
+
+void LoginQueue::push_back(WorldSession* sess)
+{
+    // no free slot at end, drop removed slots and grow if still mostly used
+    if (m_slots.size() + 1 >= m_tree.size())
+        Compact(std::max(uint32(LOGIN_QUEUE_MIN_CAPACITY), m_count * 2));
+
+    uint32 slot = m_slots.size();
+    m_slots.push_back(sess);
+    m_index[sess] = slot;
+    AddCount(slot, 1);
+
+    if (!m_count)
+        m_head = slot;
+    ++m_count;
+}
+
+bool LoginQueue::erase(WorldSession* sess)
+{
+    SlotIndex::iterator itr = m_index.find(sess);
+    if (itr == m_index.end())
+        return false;
+
+    uint32 slot = itr->second;
+    m_index.erase(itr);
+
+    m_slots[slot] = NULL;
+    AddCount(slot, -1);
+    --m_count;
+
+    if (!m_count)
+    {
+        clear();
+        return true;
+    }
+
+    // sessions after removed one moved up
+    MarkChanged(slot + 1);
+
+    while (!m_slots[m_head])
+        ++m_head;
+
+    return true;
+}
+
+void LoginQueue::pop_front()
+{
+    if (m_count)
+        erase(m_slots[m_head]);
+}
+
+void LoginQueue::clear()
+{
+    m_slots.clear();
+    m_index.clear();
+    m_tree.assign(m_tree.size(), 0);
+    m_head = 0;
+    m_count = 0;
+    m_changed = false;
+}
+
+uint32 LoginQueue::GetPosition(WorldSession* sess) const
+{
+    SlotIndex::const_iterator itr = m_index.find(sess);
+    if (itr == m_index.end())
+        return 0;
+
+    return CountBefore(itr->second) + 1;
+}
+
+bool LoginQueue::GetChangedSessions(SessionList& sessions, uint32& firstPosition)
+{
+    if (!m_changed)
+        return false;
+
+    m_changed = false;
+
+    firstPosition = CountBefore(m_changedFrom) + 1;
+
+    for (uint32 slot = m_changedFrom; slot < m_slots.size(); ++slot)
+        if (m_slots[slot])
+            sessions.push_back(m_slots[slot]);
+
+    return !sessions.empty();
+}
+
+void LoginQueue::AddCount(uint32 slot, int32 delta)
+{
+    for (uint32 i = slot + 1; i < m_tree.size(); i += i & (~i + 1))
+        m_tree[i] += delta;
+}
+
+uint32 LoginQueue::CountBefore(uint32 slot) const
+{
+    int32 count = 0;
+    for (uint32 i = slot; i > 0; i -= i & (~i + 1))
+        count += m_tree[i];
+
+    return uint32(count);
+}
+
+void LoginQueue::MarkChanged(uint32 slot)
+{
+    if (!m_changed || slot < m_changedFrom)
+        m_changedFrom = slot;
+
+    m_changed = true;
+}
+
+void LoginQueue::Compact(uint32 capacity)
+{
+    SessionList slots;
+    slots.reserve(capacity);
+
+    uint32 changedFrom = 0;                                 // live sessions before old changed slot
+    for (uint32 slot = 0; slot < m_slots.size(); ++slot)
+    {
+        if (WorldSession* sess = m_slots[slot])
+        {
+            if (slot < m_changedFrom)
+                ++changedFrom;
+
+            m_index[sess] = slots.size();
+            slots.push_back(sess);
+        }
+    }
+
+    if (m_changed)
+        m_changedFrom = changedFrom;
+
+    m_slots.swap(slots);
+    m_head = 0;
+
+    // all slots live now, build tree in linear time
+    m_tree.assign(capacity + 1, 0);
+    for (uint32 i = 1; i < m_tree.size(); ++i)
+    {
+        if (i <= m_slots.size())
+            m_tree[i] += 1;
+
+        uint32 parent = i + (i & (~i + 1));
+        if (parent < m_tree.size())
+            m_tree[parent] += m_tree[i];
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_LOGINQUEUE_H
+#define DIAMOND_LOGINQUEUE_H
+
+#include "Common.h"
+#include <map>
+#include <vector>
+
+class WorldSession;
+
+/**
+ * FIFO of sessions waiting for a free player slot.
+ *
+ * Sessions get increasing slot numbers, removed slots are left empty and
+ * a binary indexed tree over slots counts live entries, so position of any
+ * session and removal from any place are O(log n). Empty slots are compacted
+ * when the slot array has to grow.
+ *
+ * Positions changed by removals are not sent at once, the queue only remembers
+ * first changed slot and World sends the new positions at its own interval.
+ */
+class LoginQueue
+{
+    public:
+        typedef std::vector<WorldSession*> SessionList;
+
+        LoginQueue();
+
+        void push_back(WorldSession* sess);
+        bool erase(WorldSession* sess);                     // false if session not queued
+        void pop_front();
+        void clear();
+
+        WorldSession* front() const { return m_count ? m_slots[m_head] : NULL; }
+        uint32 size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+
+        uint32 GetPosition(WorldSession* sess) const;       // 1 based, 0 if not queued
+
+        // sessions with changed position in queue order, position of first stored in firstPosition
+        // returns false if no position changed since previous call
+        bool GetChangedSessions(SessionList& sessions, uint32& firstPosition);
+
+    private:
+        typedef std::map<WorldSession*, uint32> SlotIndex;
+
+        void AddCount(uint32 slot, int32 delta);
+        uint32 CountBefore(uint32 slot) const;              // live sessions in slots [0, slot)
+        void MarkChanged(uint32 slot);
+        void Compact(uint32 capacity);
+
+        SessionList m_slots;                                // NULL for removed sessions
+        std::vector<int32> m_tree;                          // 1 based binary indexed tree over m_slots
+        SlotIndex m_index;
+        uint32 m_head;                                      // first live slot
+        uint32 m_count;
+        uint32 m_changedFrom;                               // first slot with not sent position, valid if m_changed
+        bool m_changed;
+};
+#endif
@@ -39,6 +39,10 @@
 #include "InstanceSaveMgr.h"
 #include "VMapFactory.h"
 #include "BattleGroundMgr.h"
+#include "GridPreloader.h"
+#include "WaypointMovementGenerator.h"
+
+#define GRID_PRELOAD_CHECK_INTERVAL 1000                    // ms between checks of grids ahead of players
 
 struct ScriptAction
 {
@@ -119,16 +123,36 @@ void Map::LoadMap(int gx,int gy, bool reload)
 
 void Map::LoadMapAndVMap(int gx,int gy)
 {
+    // files read ahead by grid preloader, only put in place here
+    PreloadedGrid preloaded;
+    GridPreloader* preloader = sMapMgr.GetGridPreloader();
+    if (i_InstanceId == 0 && preloader && preloader->Take(i_id, gx, gy, preloaded))
+    {
+        if (preloaded.gridMap && !GridMaps[gx][gy])
+            GridMaps[gx][gy] = preloaded.gridMap;
+        else
+            delete preloaded.gridMap;
+    }
+
     LoadMap(gx,gy);
     if(i_InstanceId == 0)
         LoadVMap(gx, gy);                                   // Only load the data for the base map
-    LoadNavMesh(gx,gy);
+
+    if (preloaded.navMeshTile)
+    {
+        if (InitNavMesh())
+            AddNavMeshTile(gx, gy, preloaded.navMeshTile, preloaded.navMeshTileLength);
+        else
+            delete [] preloaded.navMeshTile;
+    }
+    else
+        LoadNavMesh(gx,gy);
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent)
   : i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
-  i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
-  m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+  i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_gridPreloadTimer(0),
+  m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_losCacheTick(1),
   m_activeNonPlayersIter(m_activeNonPlayers.end()),
   i_gridExpiry(expiry), m_parentMap(_parent ? _parent : this),
   m_navMesh(0)
@@ -142,6 +166,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
             setNGrid(NULL, idx, j);
         }
     }
+    memset(m_losCache, 0, sizeof(m_losCache));
+
     ObjectAccessor::LinkMap(this);
 
     //lets initialize visibility distance for map
@@ -512,6 +538,16 @@ bool Map::loaded(const GridPair &p) const
 
 void Map::Update(const uint32 &t_diff)
 {
+    // drop line of sight results of previous tick
+    if (++m_losCacheTick == 0)
+    {
+        memset(m_losCache, 0, sizeof(m_losCache));
+        m_losCacheTick = 1;
+    }
+
+    // expired events wait in their units for Unit::Update
+    m_eventTimerWheel.Update(t_diff);
+
     /// update players at tick
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -520,6 +556,8 @@ void Map::Update(const uint32 &t_diff)
             plr->Update(t_diff);
     }
 
+    PreloadGridsAhead(t_diff);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -1003,6 +1041,77 @@ uint32 Map::GetMaxResetDelay() const
     return mapDiff ? mapDiff->resetTime : 0;
 }
 
+void Map::PreloadGridsAhead(uint32 diff)
+{
+    // only continents have long ways over many grids
+    if (Instanceable() || !sMapMgr.GetGridPreloader())
+        return;
+
+    if (m_gridPreloadTimer > diff)
+    {
+        m_gridPreloadTimer -= diff;
+        return;
+    }
+
+    m_gridPreloadTimer = GRID_PRELOAD_CHECK_INTERVAL;
+
+    float distance = float(sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_DISTANCE));
+    if (distance <= 0.0f)
+        return;
+
+    for(MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr->IsInWorld())
+            continue;
+
+        if (plr->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE)
+        {
+            // taxi path is known, use its nodes ahead of player
+            FlightPathMovementGenerator* flight = (FlightPathMovementGenerator*)(plr->GetMotionMaster()->top());
+            TaxiPathNodeList const& path = flight->GetPath();
+
+            float prevX = plr->GetPositionX();
+            float prevY = plr->GetPositionY();
+            float left = distance;
+            for(uint32 i = flight->GetCurrentNode(); i < path.size() && left > 0.0f; ++i)
+            {
+                if (path[i].mapid != i_id)
+                    break;
+
+                left -= sqrt((path[i].x - prevX) * (path[i].x - prevX) + (path[i].y - prevY) * (path[i].y - prevY));
+                prevX = path[i].x;
+                prevY = path[i].y;
+
+                RequestGridPreload(prevX, prevY);
+            }
+        }
+        else if (plr->isMoving())
+        {
+            // straight ahead, in half grid steps to not skip grids crossed at corner
+            float angle = plr->GetOrientation();
+            for(float dist = SIZE_OF_GRIDS / 2; dist <= distance; dist += SIZE_OF_GRIDS / 2)
+                RequestGridPreload(plr->GetPositionX() + dist * cos(angle), plr->GetPositionY() + dist * sin(angle));
+        }
+    }
+}
+
+void Map::RequestGridPreload(float x, float y)
+{
+    GridPair p = Diamond::ComputeGridPair(x, y);
+    if (p.x_coord >= MAX_NUMBER_OF_GRIDS || p.y_coord >= MAX_NUMBER_OF_GRIDS)
+        return;
+
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+    // terrain, vmap and navmesh are loaded together
+    if (GridMaps[gx][gy])
+        return;
+
+    sMapMgr.GetGridPreloader()->Request(i_id, gx, gy, VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled(), true);
+}
+
 inline GridMap *Map::GetGrid(float x, float y)
 {
     // half opt method
@@ -1299,6 +1408,97 @@ bool Map::IsUnderWater(float x, float y, float z) const
     return false;
 }
 
+// 1/8 yard precision, 21 bits per coordinate
+static uint64 PackLineOfSightPoint(float x, float y, float z)
+{
+    return (uint64(int32(floor(x * 8.0f)) & 0x1FFFFF) << 42) |
+        (uint64(int32(floor(y * 8.0f)) & 0x1FFFFF) << 21) |
+        uint64(int32(floor(z * 8.0f)) & 0x1FFFFF);
+}
+
+Map::LineOfSightCacheEntry& Map::GetLineOfSightCacheEntry(uint64 from, uint64 to) const
+{
+    uint64 hash = (from ^ (to * UI64LIT(0x9E3779B97F4A7C15))) * UI64LIT(0x9E3779B97F4A7C15);
+    return m_losCache[uint32(hash >> 32) & (MAP_LOS_CACHE_SIZE - 1)];
+}
+
+bool Map::IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const
+{
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (!vmgr->isLineOfSightCalcEnabled())
+        return true;
+
+    // ray test is done in one direction only, but model triangles are double-sided, so A->B and B->A share entry
+    uint64 from = PackLineOfSightPoint(x1, y1, z1);
+    uint64 to = PackLineOfSightPoint(x2, y2, z2);
+    if (from > to)
+        std::swap(from, to);
+
+    LineOfSightCacheEntry& entry = GetLineOfSightCacheEntry(from, to);
+    if (entry.tick == m_losCacheTick && entry.from == from && entry.to == to)
+        return entry.result;
+
+    entry.from = from;
+    entry.to = to;
+    entry.tick = m_losCacheTick;
+    entry.result = vmgr->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2);
+    return entry.result;
+}
+
+void Map::IsInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count) const
+{
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (!vmgr->isLineOfSightCalcEnabled())
+    {
+        for (uint32 i = 0; i < count; ++i)
+            queries[i].result = true;
+        return;
+    }
+
+    std::vector<VMAP::LineOfSightQuery> misses;
+    std::vector<uint32> missIndex;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        VMAP::LineOfSightQuery& query = queries[i];
+        uint64 from = PackLineOfSightPoint(query.x1, query.y1, query.z1);
+        uint64 to = PackLineOfSightPoint(query.x2, query.y2, query.z2);
+        if (from > to)
+            std::swap(from, to);
+
+        LineOfSightCacheEntry const& entry = GetLineOfSightCacheEntry(from, to);
+        if (entry.tick == m_losCacheTick && entry.from == from && entry.to == to)
+            query.result = entry.result;
+        else
+        {
+            misses.push_back(query);
+            missIndex.push_back(i);
+        }
+    }
+
+    if (misses.empty())
+        return;
+
+    vmgr->isInLineOfSight(GetId(), &misses[0], misses.size());
+
+    for (uint32 i = 0; i < misses.size(); ++i)
+    {
+        VMAP::LineOfSightQuery const& query = misses[i];
+        uint64 from = PackLineOfSightPoint(query.x1, query.y1, query.z1);
+        uint64 to = PackLineOfSightPoint(query.x2, query.y2, query.z2);
+        if (from > to)
+            std::swap(from, to);
+
+        LineOfSightCacheEntry& entry = GetLineOfSightCacheEntry(from, to);
+        entry.from = from;
+        entry.to = to;
+        entry.tick = m_losCacheTick;
+        entry.result = query.result;
+
+        queries[missIndex[i]].result = query.result;
+    }
+}
+
 bool Map::CheckGridIntegrity(Creature* c, bool moved) const
 {
     Cell const& cur_cell = c->GetCurrentCell();
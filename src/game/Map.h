@@ -34,6 +34,9 @@
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
 #include "Utilities/TypeList.h"
+#include "Utilities/EventProcessor.h"
+#include "UnitPositionIndex.h"
+#include "MapEntryIndex.h"
 
 #include <bitset>
 #include <list>
@@ -51,6 +54,11 @@ struct ScriptAction;
 class BattleGround;
 class GridMap;
 
+namespace VMAP
+{
+    struct LineOfSightQuery;
+}
+
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
 #pragma pack(1)
@@ -82,6 +90,7 @@ enum LevelRequirementVsMode
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define MAP_LOS_CACHE_SIZE    256                           // line of sight results kept per map update, power of 2
 
 class DIAMOND_DLL_SPEC Map : public GridRefManager<NGridType>, public Diamond::ObjectLevelLockable<Map, ACE_Thread_Mutex>
 {
@@ -162,6 +171,18 @@ class DIAMOND_DLL_SPEC Map : public GridRefManager<NGridType>, public Diamond::O
         float GetWaterLevel(float x, float y ) const;
         bool IsUnderWater(float x, float y, float z) const;
 
+        // vmap line of sight, results are cached till next map update for nearly same points (1/8 yard)
+        bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
+        void IsInLineOfSight(VMAP::LineOfSightQuery* queries, uint32 count) const;
+
+        // shared scheduler of events of units in map
+        EventTimerWheel& GetEventTimerWheel() { return m_eventTimerWheel; }
+        // positions of units in world for area searches
+        UnitPositionIndex& GetUnitPositionIndex() { return m_unitPositionIndex; }
+        // creatures (not pets) and gameobjects in world by entry, for searches by entry
+        MapEntryIndex<Creature>& GetCreatureEntryIndex() { return m_creatureEntryIndex; }
+        MapEntryIndex<GameObject>& GetGameObjectEntryIndex() { return m_gameObjectEntryIndex; }
+
         static uint32 GetAreaIdByAreaFlag(uint16 areaflag,uint32 map_id);
         static uint32 GetZoneIdByAreaFlag(uint16 areaflag,uint32 map_id);
         static void GetZoneAndAreaIdByAreaFlag(uint32& zoneid, uint32& areaid, uint16 areaflag,uint32 map_id);
@@ -276,6 +297,9 @@ class DIAMOND_DLL_SPEC Map : public GridRefManager<NGridType>, public Diamond::O
         void LoadMap(int gx,int gy, bool reload = false);
         GridMap *GetGrid(float x, float y);
 
+        void PreloadGridsAhead(uint32 diff);
+        void RequestGridPreload(float x, float y);
+
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf( Player * player );
@@ -322,8 +346,27 @@ class DIAMOND_DLL_SPEC Map : public GridRefManager<NGridType>, public Diamond::O
         uint32 i_id;
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
+        uint32 m_gridPreloadTimer;
         float m_VisibleDistance;
 
+        struct LineOfSightCacheEntry
+        {
+            uint64 from;                                    // packed points, lower one stored as from
+            uint64 to;
+            uint32 tick;                                    // valid if equal m_losCacheTick
+            bool result;
+        };
+
+        LineOfSightCacheEntry& GetLineOfSightCacheEntry(uint64 from, uint64 to) const;
+
+        mutable LineOfSightCacheEntry m_losCache[MAP_LOS_CACHE_SIZE];
+        uint32 m_losCacheTick;
+
+        EventTimerWheel m_eventTimerWheel;
+        UnitPositionIndex m_unitPositionIndex;
+        MapEntryIndex<Creature> m_creatureEntryIndex;
+        MapEntryIndex<GameObject> m_gameObjectEntryIndex;
+
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
 
@@ -389,7 +432,9 @@ class DIAMOND_DLL_SPEC Map : public GridRefManager<NGridType>, public Diamond::O
         dtNavMesh* GetNavMesh();
 
     private:
+        bool InitNavMesh();
         void LoadNavMesh(int gx, int gy);
+        void AddNavMeshTile(int gx, int gy, unsigned char* data, int length);
         void UnloadNavMesh(int gx, int gy);
         dtNavMesh* m_navMesh;
         UNORDERED_MAP<uint32, uint32> m_mmapTileMap;    // maps [map grid coords] to [dtTile coords]
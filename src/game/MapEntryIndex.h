@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_MAPENTRYINDEX_H
+#define DIAMOND_MAPENTRYINDEX_H
+
+#include "Common.h"
+#include "Object.h"
+#include <vector>
+#include <algorithm>
+
+/**
+ * Objects of one type in world of one map, grouped by entry.
+ *
+ * Lets searches for a known entry (mostly from scripts) check only the objects
+ * of that entry instead of visiting all objects of the grid cells in range.
+ * Objects are added in AddToWorld and removed in RemoveFromWorld. Object keeps
+ * the entry it is listed under, so entry changes not passed to UpdateEntry can't
+ * leave it behind in the index at removal.
+ */
+template<class T>
+class MapEntryIndex
+{
+    public:
+        typedef std::vector<T*> ObjectList;
+
+        void Insert(T* obj)
+        {
+            ASSERT(!obj->m_entryIndexKey);
+            obj->m_entryIndexKey = obj->GetEntry();
+            m_objects[obj->m_entryIndexKey].push_back(obj);
+        }
+
+        void Remove(T* obj)
+        {
+            typename EntryMap::iterator itr = m_objects.find(obj->m_entryIndexKey);
+            ASSERT(itr != m_objects.end());
+
+            ObjectList& objects = itr->second;
+            typename ObjectList::iterator o_itr = std::find(objects.begin(), objects.end(), obj);
+            ASSERT(o_itr != objects.end());
+
+            *o_itr = objects.back();
+            objects.pop_back();
+
+            if (objects.empty())
+                m_objects.erase(itr);
+
+            obj->m_entryIndexKey = 0;
+        }
+
+        /// move listed object to its current entry
+        void UpdateEntry(T* obj)
+        {
+            if (obj->m_entryIndexKey && obj->m_entryIndexKey != obj->GetEntry())
+            {
+                Remove(obj);
+                Insert(obj);
+            }
+        }
+
+        /// objects with entry in map or NULL if none
+        ObjectList const* GetObjects(uint32 entry) const
+        {
+            typename EntryMap::const_iterator itr = m_objects.find(entry);
+            return itr != m_objects.end() ? &itr->second : NULL;
+        }
+
+        /// nearest object with entry within range of source, in same phase and accepted by check
+        template<class Check>
+        T* GetClosest(WorldObject const* source, uint32 entry, float range, Check& check) const
+        {
+            ObjectList const* objects = GetObjects(entry);
+            if (!objects)
+                return NULL;
+
+            T* closest = NULL;
+            for (typename ObjectList::const_iterator itr = objects->begin(); itr != objects->end(); ++itr)
+            {
+                // entry can be changed without UpdateEntry call
+                if ((*itr)->GetEntry() != entry || !source->IsWithinDistInMap(*itr, range) || !check(*itr))
+                    continue;
+
+                closest = *itr;
+                range = source->GetDistance(closest);
+            }
+
+            return closest;
+        }
+
+        T* GetClosest(WorldObject const* source, uint32 entry, float range) const
+        {
+            AnyObjectCheck check;
+            return GetClosest(source, entry, range, check);
+        }
+
+    private:
+        struct AnyObjectCheck
+        {
+            bool operator()(T*) const { return true; }
+        };
+
+        typedef UNORDERED_MAP<uint32, ObjectList> EntryMap;
+
+        EntryMap m_objects;
+};
+
+#endif
@@ -29,19 +29,25 @@
 #include "CellImpl.h"
 #include "Corpse.h"
 #include "ObjectMgr.h"
+#include "GridPreloader.h"
+
+#define GRID_PRELOADER_MAX_QUEUED 64                        // requests over this are skipped until loader catches up
 
 #define CLASS_LOCK Diamond::ClassLevelLockable<MapManager, ACE_Thread_Mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, ACE_Thread_Mutex);
 
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)),
+    i_gridPreloader(NULL), i_gridPreloaderThread(NULL)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
 
 MapManager::~MapManager()
 {
+    StopGridPreloader();
+
     for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
         delete iter->second;
 
@@ -56,6 +62,35 @@ MapManager::Initialize()
 {
     InitStateMachine();
     InitMaxInstanceId();
+
+    if (sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_DISTANCE))
+        StartGridPreloader();
+}
+
+void MapManager::StartGridPreloader()
+{
+    if (i_gridPreloaderThread)
+        return;
+
+    i_gridPreloader = new GridPreloader(sWorld.GetDataPath(), GRID_PRELOADER_MAX_QUEUED);
+    i_gridPreloader->incReference();                        // keep body alive after thread exit, deleted in StopGridPreloader
+    i_gridPreloaderThread = new ACE_Based::Thread(i_gridPreloader);
+    i_gridPreloaderThread->setPriority(ACE_Based::Low);
+}
+
+void MapManager::StopGridPreloader()
+{
+    if (!i_gridPreloaderThread)
+        return;
+
+    i_gridPreloader->Stop();
+    i_gridPreloaderThread->wait();
+
+    delete i_gridPreloaderThread;
+    i_gridPreloaderThread = NULL;
+
+    i_gridPreloader->decReference();
+    i_gridPreloader = NULL;
 }
 
 void MapManager::InitStateMachine()
@@ -279,6 +314,9 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    // no more grid loads expected
+    StopGridPreloader();
+
     for(MapMapType::iterator iter=i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
@@ -28,6 +28,12 @@
 
 class Transport;
 class BattleGround;
+class GridPreloader;
+
+namespace ACE_Based
+{
+    class Thread;
+}
 
 class DIAMOND_DLL_DECL MapManager : public Diamond::Singleton<MapManager, Diamond::ClassLevelLockable<MapManager, ACE_Thread_Mutex> >
 {
@@ -131,6 +137,9 @@ class DIAMOND_DLL_DECL MapManager : public Diamond::Singleton<MapManager, Diamon
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
 
+        // NULL if grid preloading disabled or stopped
+        GridPreloader* GetGridPreloader() const { return i_gridPreloader; }
+
     private:
 
         // debugging code, should be deleted some day
@@ -148,6 +157,9 @@ class DIAMOND_DLL_DECL MapManager : public Diamond::Singleton<MapManager, Diamon
         void InitStateMachine();
         void DeleteStateMachine();
 
+        void StartGridPreloader();
+        void StopGridPreloader();
+
         Map* _createBaseMap(uint32 id);
         Map* _findMap(uint32 id) const
         {
@@ -161,6 +173,9 @@ class DIAMOND_DLL_DECL MapManager : public Diamond::Singleton<MapManager, Diamon
         IntervalTimer i_timer;
 
         uint32 i_MaxInstanceId;
+
+        GridPreloader* i_gridPreloader;
+        ACE_Based::Thread* i_gridPreloaderThread;
 };
 
 #define sMapMgr MapManager::Instance()
@@ -7,45 +7,52 @@
 inline uint32 packTileID(uint32 tileX, uint32 tileY) { return tileX<<16 | tileY; }
 inline void unpackTileID(uint32 ID, uint32 &tileX, uint32 &tileY) { tileX = ID>>16; tileY = ID&0xFF; }
 
-void Map::LoadNavMesh(int gx, int gy)
+bool Map::InitNavMesh()
 {
+    if(m_navMesh)
+        return true;
+
     char fileName[512];
-    FILE* file;
+    sprintf(fileName, "%smmaps/%03i.mmap", sWorld.GetDataPath().c_str(), i_id);
+    FILE* file = fopen(fileName, "rb");
 
-    if(!m_navMesh)
+    if(!file)
     {
-        sprintf(fileName, "%smmaps/%03i.mmap", sWorld.GetDataPath().c_str(), i_id);
-        file = fopen(fileName, "rb");
-
-        if(!file)
-        {
-            sLog.outError("Error: Could not open mmap file '%s'", fileName);
-            return;
-        }
-
-        dtNavMeshParams params;
-        uint32 offset;
-        fread(&params, sizeof(dtNavMeshParams), 1, file);
-        fread(&offset, sizeof(uint32), 1, file);
-        fclose(file);
-
-        m_navMesh = new dtNavMesh;
-        if(!m_navMesh->init(&params))
-        {
-            delete m_navMesh;
-            m_navMesh = 0;
-            sLog.outError("Error: Failed to initialize mmap %03u from file %s", i_id, fileName);
-            return;
-        }
+        sLog.outError("Error: Could not open mmap file '%s'", fileName);
+        return false;
     }
 
+    dtNavMeshParams params;
+    uint32 offset;
+    fread(&params, sizeof(dtNavMeshParams), 1, file);
+    fread(&offset, sizeof(uint32), 1, file);
+    fclose(file);
+
+    m_navMesh = new dtNavMesh;
+    if(!m_navMesh->init(&params))
+    {
+        delete m_navMesh;
+        m_navMesh = 0;
+        sLog.outError("Error: Failed to initialize mmap %03u from file %s", i_id, fileName);
+        return false;
+    }
+
+    return true;
+}
+
+void Map::LoadNavMesh(int gx, int gy)
+{
+    if(!InitNavMesh())
+        return;
+
     uint32 packedGridPos = packTileID(uint32(gx), uint32(gy));
     if(m_mmapTileMap.find(packedGridPos) != m_mmapTileMap.end())
         return;
 
     // mmaps/0000000.mmtile
+    char fileName[512];
     sprintf(fileName, "%smmaps/%03i%02i%02i.mmtile", sWorld.GetDataPath().c_str(), i_id, gx, gy);
-    file = fopen(fileName, "rb");
+    FILE* file = fopen(fileName, "rb");
 
     if(!file)
     {
@@ -61,6 +68,19 @@ void Map::LoadNavMesh(int gx, int gy)
     fread(data, length, 1, file);
     fclose(file);
 
+    AddNavMeshTile(gx, gy, data, length);
+}
+
+// data is mmtile file content, read here or by grid preloader; deleted here at fail
+void Map::AddNavMeshTile(int gx, int gy, unsigned char* data, int length)
+{
+    uint32 packedGridPos = packTileID(uint32(gx), uint32(gy));
+    if(m_mmapTileMap.find(packedGridPos) != m_mmapTileMap.end())
+    {
+        delete [] data;
+        return;
+    }
+
     dtMeshHeader* header = (dtMeshHeader*)data;
     if (header->magic != DT_NAVMESH_MAGIC)
     {
@@ -34,6 +34,7 @@ class DIAMOND_DLL_DECL NullCreatureAI : public CreatureAI
         void EnterEvadeMode() {}
 
         bool IsVisible(Unit *) const { return false;  }
+        uint32 GetLineOfSightInterest() const { return LOS_INTEREST_NONE; }
 
         void UpdateAI(const uint32) {}
         static int Permissible(const Creature *) { return PERMIT_BASE_IDLE;  }
@@ -591,135 +591,126 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer * data, UpdateMask *
     // 2 specialized loops for speed optimization in non-unit case
     if(isType(TYPEMASK_UNIT))                               // unit (creature/player) case
     {
-        for( uint16 index = 0; index < m_valuesCount; ++index )
+        for( uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1) )
         {
-            if( updateMask->GetBit( index ) )
+            if( index == UNIT_NPC_FLAGS )
             {
-                if( index == UNIT_NPC_FLAGS )
+                // remove custom flag before sending
+                uint32 appendValue = m_uint32Values[ index ] & ~UNIT_NPC_FLAG_GUARD;
+
+                if (GetTypeId() == TYPEID_UNIT)
                 {
-                    // remove custom flag before sending
-                    uint32 appendValue = m_uint32Values[ index ] & ~UNIT_NPC_FLAG_GUARD;
+                    if (!target->canSeeSpellClickOn((Creature*)this))
+                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->isCanTrainingOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
+                        if (!((Creature*)this)->isCanTrainingOf(target, false))
+                            appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
                     }
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    if(IsPerCasterAuraState)
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
                     {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE,target->GetGUID()))
-                            *data << m_uint32Values[ index ];
-                        else
-                            *data << (m_uint32Values[ index ] & ~(1 << (AURA_STATE_CONFLAGRATE-1)));
+                        if (target->getClass() != CLASS_HUNTER)
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
                     }
-                    else
-                        *data << m_uint32Values[ index ];
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if(index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[ index ] < 0 ? 0 : m_floatValues[ index ]);
-                }
-
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                    (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[ index ]);
                 }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if(index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[ index ] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                // hide lootable animation for unallowed players
-                else if(index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+                *data << uint32(appendValue);
+            }
+            else if (index == UNIT_FIELD_AURASTATE)
+            {
+                if(IsPerCasterAuraState)
                 {
-                    if(!target->isAllowedToLoot((Creature*)this))
-                        *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_LOOTABLE);
+                    // IsPerCasterAuraState set if related pet caster aura state set already
+                    if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE,target->GetGUID()))
+                        *data << m_uint32Values[ index ];
                     else
-                        *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_TAPPED);
+                        *data << (m_uint32Values[ index ] & ~(1 << (AURA_STATE_CONFLAGRATE-1)));
                 }
                 else
-                {
-                    // send in current format (float as float, uint32 as uint32)
                     *data << m_uint32Values[ index ];
-                }
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if(index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[ index ] < 0 ? 0 : m_floatValues[ index ]);
+            }
+
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[ index ]);
+            }
+
+            // Gamemasters should be always able to select units - remove not selectable flag
+            else if(index == UNIT_FIELD_FLAGS && target->isGameMaster())
+            {
+                *data << (m_uint32Values[ index ] & ~UNIT_FLAG_NOT_SELECTABLE);
+            }
+            // hide lootable animation for unallowed players
+            else if(index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+            {
+                if(!target->isAllowedToLoot((Creature*)this))
+                    *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_LOOTABLE);
+                else
+                    *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_TAPPED);
+            }
+            else
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[ index ];
             }
         }
     }
     else if(isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
     {
-        for( uint16 index = 0; index < m_valuesCount; ++index )
+        for( uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1) )
         {
-            if( updateMask->GetBit( index ) )
+            // send in current format (float as float, uint32 as uint32)
+            if ( index == GAMEOBJECT_DYNAMIC )
             {
-                // send in current format (float as float, uint32 as uint32)
-                if ( index == GAMEOBJECT_DYNAMIC )
+                if(IsActivateToQuest )
                 {
-                    if(IsActivateToQuest )
+                    switch(((GameObject*)this)->GetGoType())
                     {
-                        switch(((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_CHEST:
-                                // enable quest object. Represent 9, but 1 for client before 2.3.0
-                                *data << uint16(9);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(1);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
+                        case GAMEOBJECT_TYPE_CHEST:
+                            // enable quest object. Represent 9, but 1 for client before 2.3.0
+                            *data << uint16(9);
+                            *data << uint16(-1);
+                            break;
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            *data << uint16(1);
+                            *data << uint16(-1);
+                            break;
+                        default:
+                            // unknown, not happen.
+                            *data << uint16(0);
+                            *data << uint16(-1);
+                            break;
                     }
                 }
                 else
-                    *data << m_uint32Values[ index ];       // other cases
+                {
+                    // disable quest object
+                    *data << uint16(0);
+                    *data << uint16(-1);
+                }
             }
+            else
+                *data << m_uint32Values[ index ];       // other cases
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for( uint16 index = 0; index < m_valuesCount; ++index )
+        for( uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1) )
         {
-            if( updateMask->GetBit( index ) )
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[ index ];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[ index ];
         }
     }
 }
@@ -727,13 +718,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer * data, UpdateMask *
 void Object::ClearUpdateMask(bool remove)
 {
     if(m_uint32Values)
-    {
-        for( uint16 index = 0; index < m_valuesCount; ++index )
-        {
-            if(m_uint32Values_mirror[index]!= m_uint32Values[index])
-                m_uint32Values_mirror[index] = m_uint32Values[index];
-        }
-    }
+        memcpy(m_uint32Values_mirror, m_uint32Values, m_valuesCount*sizeof(uint32));
 
     if(m_objectUpdated)
     {
@@ -764,20 +749,12 @@ bool Object::LoadValues(const char* data)
 
 void Object::_SetUpdateBits(UpdateMask *updateMask, Player* /*target*/) const
 {
-    for( uint16 index = 0; index < m_valuesCount; ++index )
-    {
-        if(m_uint32Values_mirror[index]!= m_uint32Values[index])
-            updateMask->SetBit(index);
-    }
+    updateMask->SetDifferentBits(m_uint32Values, m_uint32Values_mirror);
 }
 
 void Object::_SetCreateBits(UpdateMask *updateMask, Player* /*target*/) const
 {
-    for( uint16 index = 0; index < m_valuesCount; ++index )
-    {
-        if(GetUInt32Value(index) != 0)
-            updateMask->SetBit(index);
-    }
+    updateMask->SetNonZeroBits(m_uint32Values);
 }
 
 void Object::SetInt32Value( uint16 index, int32 value )
@@ -852,6 +829,10 @@ void Object::SetFloatValue( uint16 index, float value )
                 AddToClientUpdateList();
                 m_objectUpdated = true;
             }
+
+            // object size is also kept in area search index of map
+            if(index == UNIT_FIELD_BOUNDINGRADIUS && isType(TYPEMASK_UNIT))
+                ((Unit*)this)->GetMap()->GetUnitPositionIndex().UpdateObjectSize((Unit*)this);
         }
     }
 }
@@ -1115,6 +1096,8 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     if(isType(TYPEMASK_UNIT))
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+        if(IsInWorld())
+            GetMap()->GetUnitPositionIndex().Relocate((Unit*)this);
         if(((Creature*)this)->isVehicle())
             ((Vehicle*)this)->RellocatePassengers(GetMap());
     }
@@ -1129,6 +1112,8 @@ void WorldObject::Relocate(float x, float y, float z)
     if(isType(TYPEMASK_UNIT))
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+        if(IsInWorld())
+            GetMap()->GetUnitPositionIndex().Relocate((Unit*)this);
         if(((Creature*)this)->isVehicle())
             ((Vehicle*)this)->RellocatePassengers(GetMap());
     }
@@ -1265,6 +1250,8 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz) const
 {
     float x,y,z;
     GetPosition(x,y,z);
+    if (m_currMap)
+        return m_currMap->IsInLineOfSight(x, y, z+2.0f, ox, oy, oz+2.0f);
     VMAP::IVMapManager *vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
     return vMapManager->isInLineOfSight(GetMapId(), x, y, z+2.0f, ox, oy, oz+2.0f);
 }
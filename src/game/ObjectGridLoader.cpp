@@ -141,15 +141,14 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair &cell, GridRefManager<T> &
 
 void LoadHelper(CellCorpseSet const& cell_corpses, CellPair &cell, CorpseMapType &m, uint32 &count, Map* map, GridType& grid)
 {
-    if(cell_corpses.empty())
+    // only corpses of this map instance
+    CellCorpseSet::const_iterator instItr = cell_corpses.find(map->GetInstanceId());
+    if(instItr == cell_corpses.end())
         return;
 
-    for(CellCorpseSet::const_iterator itr = cell_corpses.begin(); itr != cell_corpses.end(); ++itr)
+    for(CellGuidSet::const_iterator itr = instItr->second.begin(); itr != instItr->second.end(); ++itr)
     {
-        if(itr->second != map->GetInstanceId())
-            continue;
-
-        uint32 player_guid = itr->first;
+        uint32 player_guid = *itr;
 
         Corpse *obj = sObjectAccessor.GetCorpseForPlayerGUID(player_guid);
         if(!obj)
@@ -45,6 +45,7 @@
 #include "GossipDef.h"
 #include "Mail.h"
 #include "InstanceData.h"
+#include "QueryResponseCache.h"
 
 #include <limits>
 
@@ -153,7 +154,8 @@ ObjectMgr::ObjectMgr() :
     m_GuildIds("Guild ids"),
     m_MailIds("Mail ids"),
     m_PetNumbers("Pet numbers"),
-    m_GroupIds("Group ids")
+    m_GroupIds("Group ids"),
+    m_expiredMails(NULL), m_expiredMailsTime(0), m_expiredMailsCount(0), m_expiredMailsPending(false)
 {
     // Only zero condition left, others will be added while loading DB tables
     mConditions.resize(1);
@@ -161,6 +163,8 @@ ObjectMgr::ObjectMgr() :
 
 ObjectMgr::~ObjectMgr()
 {
+    delete m_expiredMails;
+
     for( QuestMap::iterator i = mQuestTemplates.begin( ); i != mQuestTemplates.end( ); ++i )
         delete i->second;
 
@@ -271,6 +275,7 @@ CreatureInfo const* ObjectMgr::GetCreatureTemplate(uint32 id)
 
 void ObjectMgr::LoadCreatureLocales()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_CREATURE);
     mCreatureLocaleMap.clear();                              // need for reload case
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,name_loc1,subname_loc1,name_loc2,subname_loc2,name_loc3,subname_loc3,name_loc4,subname_loc4,name_loc5,subname_loc5,name_loc6,subname_loc6,name_loc7,subname_loc7,name_loc8,subname_loc8 FROM locales_creature");
@@ -433,6 +438,7 @@ struct SQLCreatureLoader : public SQLStorageLoaderBase<SQLCreatureLoader>
 
 void ObjectMgr::LoadCreatureTemplates()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_CREATURE);
     SQLCreatureLoader loader;
     loader.Load(sCreatureStorage);
 
@@ -1468,14 +1474,14 @@ void ObjectMgr::LoadCreatureRespawnTimes()
         uint64 respawn_time = fields[1].GetUInt64();
         uint32 instance     = fields[2].GetUInt32();
 
-        mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)] = time_t(respawn_time);
+        mCreatureRespawnTimes[instance][loguid] = time_t(respawn_time);
 
         ++count;
     } while (result->NextRow());
 
     delete result;
 
-    sLog.outString( ">> Loaded %lu creature respawn times", (unsigned long)mCreatureRespawnTimes.size() );
+    sLog.outString( ">> Loaded %u creature respawn times", count );
 }
 
 void ObjectMgr::LoadGameobjectRespawnTimes()
@@ -1500,50 +1506,141 @@ void ObjectMgr::LoadGameobjectRespawnTimes()
         uint64 respawn_time = fields[1].GetUInt64();
         uint32 instance     = fields[2].GetUInt32();
 
-        mGORespawnTimes[MAKE_PAIR64(loguid,instance)] = time_t(respawn_time);
+        mGORespawnTimes[instance][loguid] = time_t(respawn_time);
 
         ++count;
     } while (result->NextRow());
 
     delete result;
 
-    sLog.outString( ">> Loaded %lu gameobject respawn times", (unsigned long)mGORespawnTimes.size() );
+    sLog.outString( ">> Loaded %u gameobject respawn times", count );
 }
 
-// name must be checked to correctness (if received) before call this function
-uint64 ObjectMgr::GetPlayerGUIDByName(std::string name) const
+void ObjectMgr::LoadPlayerIdentities()
 {
-    uint64 guid = 0;
+    mPlayerIdentities.clear();
+    mPlayerNameIndex.clear();
 
-    CharacterDatabase.escape_string(name);
+    //                                                    0    1    2    3     4      5     6
+    QueryResult *result = CharacterDatabase.Query("SELECT guid,name,race,class,gender,level,account FROM characters");
 
-    // Player name safe to sending to DB (checked at login) and this function using
-    QueryResult *result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE name = '%s'", name.c_str());
-    if(result)
+    if(!result)
     {
-        guid = MAKE_NEW_GUID((*result)[0].GetUInt32(), 0, HIGHGUID_PLAYER);
+        sLog.outString(">> Loaded 0 character identities.");
+        return;
+    }
 
-        delete result;
+    do
+    {
+        Field *fields = result->Fetch();
+
+        SetPlayerIdentity(fields[0].GetUInt32(), fields[1].GetCppString(), fields[6].GetUInt32(),
+            fields[2].GetUInt8(), fields[3].GetUInt8(), fields[4].GetUInt8(), fields[5].GetUInt8());
+    } while (result->NextRow());
+
+    delete result;
+
+    sLog.outString( ">> Loaded %lu character identities", (unsigned long)mPlayerIdentities.size() );
+}
+
+// DB name comparison is case insensitive, keep same for index lookups
+std::string ObjectMgr::MakePlayerNameKey(std::string const& name)
+{
+    std::wstring wname;
+    if(!Utf8toWStr(name, wname))
+        return name;
+
+    wstrToLower(wname);
+
+    std::string key;
+    if(!WStrToUtf8(wname, key))
+        return name;
+
+    return key;
+}
+
+void ObjectMgr::SetPlayerIdentity(uint32 lowguid, std::string const& name, uint32 account, uint8 race, uint8 class_, uint8 gender, uint8 level)
+{
+    PlayerIdentity& identity = mPlayerIdentities[lowguid];
+    identity.account = account;
+    identity.race    = race;
+    identity.class_  = class_;
+    identity.gender  = gender;
+    identity.level   = level;
+
+    if(identity.name != name)
+        SetPlayerIdentityName(lowguid, name);
+}
+
+void ObjectMgr::SetPlayerIdentityName(uint32 lowguid, std::string const& name)
+{
+    PlayerIdentityMap::iterator itr = mPlayerIdentities.find(lowguid);
+    if(itr == mPlayerIdentities.end())
+        return;
+
+    if(!itr->second.name.empty())
+    {
+        PlayerNameIndexMap::iterator nItr = mPlayerNameIndex.find(MakePlayerNameKey(itr->second.name));
+        if(nItr != mPlayerNameIndex.end() && nItr->second == lowguid)
+            mPlayerNameIndex.erase(nItr);
     }
 
-    return guid;
+    itr->second.name = name;
+
+    // first owner keep name if duplicate loaded from dump (renamed at login)
+    if(!name.empty())
+        mPlayerNameIndex.insert(PlayerNameIndexMap::value_type(MakePlayerNameKey(name), lowguid));
+}
+
+void ObjectMgr::SetPlayerIdentityGender(uint32 lowguid, uint8 gender)
+{
+    PlayerIdentityMap::iterator itr = mPlayerIdentities.find(lowguid);
+    if(itr != mPlayerIdentities.end())
+        itr->second.gender = gender;
+}
+
+void ObjectMgr::SetPlayerIdentityLevel(uint32 lowguid, uint8 level)
+{
+    PlayerIdentityMap::iterator itr = mPlayerIdentities.find(lowguid);
+    if(itr != mPlayerIdentities.end())
+        itr->second.level = level;
+}
+
+void ObjectMgr::RemovePlayerIdentity(uint32 lowguid)
+{
+    PlayerIdentityMap::iterator itr = mPlayerIdentities.find(lowguid);
+    if(itr == mPlayerIdentities.end())
+        return;
+
+    SetPlayerIdentityName(lowguid, "");
+    mPlayerIdentities.erase(itr);
+}
+
+// name must be checked to correctness (if received) before call this function
+uint64 ObjectMgr::GetPlayerGUIDByName(std::string name) const
+{
+    if(name.empty())
+        return 0;
+
+    PlayerNameIndexMap::const_iterator itr = mPlayerNameIndex.find(MakePlayerNameKey(name));
+    if(itr == mPlayerNameIndex.end())
+        return 0;
+
+    return MAKE_NEW_GUID(itr->second, 0, HIGHGUID_PLAYER);
 }
 
 bool ObjectMgr::GetPlayerNameByGUID(const uint64 &guid, std::string &name) const
 {
-    // prevent DB access for online player
+    // online player name can be not saved yet
     if(Player* player = GetPlayer(guid))
     {
         name = player->GetName();
         return true;
     }
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT name FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-
-    if(result)
+    if(PlayerIdentity const* identity = GetPlayerIdentity(GUID_LOPART(guid)))
     {
-        name = (*result)[0].GetCppString();
-        delete result;
+        name = identity->name;
         return true;
     }
 
@@ -1552,58 +1649,42 @@ bool ObjectMgr::GetPlayerNameByGUID(const uint64 &guid, std::string &name) const
 
 uint32 ObjectMgr::GetPlayerTeamByGUID(const uint64 &guid) const
 {
-    // prevent DB access for online player
     if(Player* player = GetPlayer(guid))
     {
         return Player::TeamForRace(player->getRace());
     }
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT race FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-
-    if(result)
-    {
-        uint8 race = (*result)[0].GetUInt8();
-        delete result;
-        return Player::TeamForRace(race);
-    }
+    if(PlayerIdentity const* identity = GetPlayerIdentity(GUID_LOPART(guid)))
+        return Player::TeamForRace(identity->race);
 
     return 0;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByGUID(const uint64 &guid) const
 {
-    // prevent DB access for online player
     if(Player* player = GetPlayer(guid))
     {
         return player->GetSession()->GetAccountId();
     }
 
-    QueryResult *result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE guid = '%u'", GUID_LOPART(guid));
-    if(result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
-    }
+    if(PlayerIdentity const* identity = GetPlayerIdentity(GUID_LOPART(guid)))
+        return identity->account;
 
     return 0;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
 {
-    QueryResult *result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE name = '%s'", name.c_str());
-    if(result)
-    {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
-    }
+    if(uint64 guid = GetPlayerGUIDByName(name))
+        if(PlayerIdentity const* identity = GetPlayerIdentity(GUID_LOPART(guid)))
+            return identity->account;
 
     return 0;
 }
 
 void ObjectMgr::LoadItemLocales()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_ITEM);
     mItemLocaleMap.clear();                                 // need for reload case
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,name_loc1,description_loc1,name_loc2,description_loc2,name_loc3,description_loc3,name_loc4,description_loc4,name_loc5,description_loc5,name_loc6,description_loc6,name_loc7,description_loc7,name_loc8,description_loc8 FROM locales_item");
@@ -1667,6 +1748,7 @@ struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader>
 
 void ObjectMgr::LoadItemPrototypes()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_ITEM);
     SQLItemLoader loader;
     loader.Load(sItemStorage);
     sLog.outString( ">> Loaded %u item prototypes", sItemStorage.RecordCount );
@@ -4494,6 +4576,7 @@ void ObjectMgr::LoadCreatureMovementScripts()
 
 void ObjectMgr::LoadPageTexts()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     sPageTextStore.Free();                                  // for reload case
 
     sPageTextStore.Load();
@@ -4537,6 +4620,7 @@ void ObjectMgr::LoadPageTexts()
 
 void ObjectMgr::LoadPageTextLocales()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     mPageTextLocaleMap.clear();                             // need for reload case
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,text_loc1,text_loc2,text_loc3,text_loc4,text_loc5,text_loc6,text_loc7,text_loc8 FROM locales_page_text");
@@ -4648,6 +4732,7 @@ GossipText const *ObjectMgr::GetGossipText(uint32 Text_ID) const
 
 void ObjectMgr::LoadGossipText()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     QueryResult *result = WorldDatabase.Query( "SELECT * FROM npc_text" );
 
     int count = 0;
@@ -4697,6 +4782,7 @@ void ObjectMgr::LoadGossipText()
 
 void ObjectMgr::LoadNpcTextLocales()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     mNpcTextLocaleMap.clear();                              // need for reload case
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,"
@@ -4760,98 +4846,161 @@ void ObjectMgr::LoadNpcTextLocales()
     sLog.outString( ">> Loaded %lu NpcText locale strings", (unsigned long)mNpcTextLocaleMap.size() );
 }
 
-//not very fast function but it is called only once a day, or on starting-up
+// expired mails processed per world update, mail with all its items is never split
+#define EXPIRED_MAILS_PER_UPDATE 200
+
+// called at starting-up (processed at once) and once a day (query async, processed in chunks from World::Update)
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
+    // previous pass not finished yet
+    if (m_expiredMailsPending || m_expiredMails)
+        return;
+
     time_t basetime = time(NULL);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    //                                     0       1           2      3             4         5           6   7       8              9
+    char const* expiredMailsQuery = "SELECT mail.id,messageType,sender,mail.receiver,has_items,expire_time,cod,checked,mailTemplateId,item_guid "
+        "FROM mail LEFT JOIN mail_items ON mail.id = mail_items.mail_id WHERE expire_time < '" UI64FMTD "' ORDER BY mail.id";
+
+    if (serverUp)
+    {
+        m_expiredMailsPending = true;
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, (uint64)basetime, expiredMailsQuery, (uint64)basetime);
+        return;
+    }
+
     //delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
-    //                                                     0  1           2      3        4         5           6   7       8
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
-    if ( !result )
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
+
+    m_expiredMails = CharacterDatabase.PQuery(expiredMailsQuery, (uint64)basetime);
+    if (!m_expiredMails)
     {
         sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
         return;                                             // any mails need to be returned or deleted
     }
 
-    //std::ostringstream delitems, delmails; //will be here for optimization
-    //bool deletemail = false, deleteitem = false;
-    //delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    //delmails << "DELETE FROM mail WHERE id IN ( "
+    m_expiredMailsTime = basetime;
+    m_expiredMailsCount = 0;
 
-    uint32 count = 0;
-    Field *fields;
+    // no players online, do all at once
+    while (UpdateExpiredMails(false)) {}
 
-    do
+    sLog.outString( ">> Loaded %u mails", m_expiredMailsCount );
+}
+
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime)
+{
+    m_expiredMailsPending = false;
+
+    if (!result)
+        return;
+
+    m_expiredMails = result;
+    m_expiredMailsTime = time_t(basetime);
+    m_expiredMailsCount = 0;
+}
+
+bool ObjectMgr::UpdateExpiredMails(bool serverUp)
+{
+    if (!m_expiredMails)
+        return false;
+
+    std::ostringstream delItems, delMails;
+    bool hasDelItems = false, hasDelMails = false;
+    bool hasMore = true;
+    bool inTransaction = false;
+
+    for (uint32 processed = 0; processed < EXPIRED_MAILS_PER_UPDATE && hasMore; ++processed)
     {
-        fields = result->Fetch();
-        Mail *m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiver = fields[3].GetUInt32();
-        bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player *pl = 0;
-        if (serverUp)
-            pl = GetPlayer((uint64)m->receiver);
-        if (pl)
-        {                                                   //this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            //his in mailbox and he has already listed his mails )
-            delete m;
-            continue;
-        }
-        //delete or return mail:
-        if (has_items)
+        Field *fields = m_expiredMails->Fetch();
+        uint32 messageID   = fields[0].GetUInt32();
+        uint8 messageType  = fields[1].GetUInt8();
+        uint32 sender      = fields[2].GetUInt32();
+        uint32 receiver    = fields[3].GetUInt32();
+        bool has_items     = fields[4].GetBool();
+        uint32 checked     = fields[7].GetUInt32();
+
+        // rows of one mail, one per item (or single row with NULL item_guid)
+        std::vector<uint32> itemGuids;
+        do
         {
-            QueryResult *resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if(resultItems)
-            {
-                do
-                {
-                    Field *fields2 = resultItems->Fetch();
+            fields = m_expiredMails->Fetch();
+            if (fields[0].GetUInt32() != messageID)
+                break;
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+            if (uint32 item_guid = fields[9].GetUInt32())
+                itemGuids.push_back(item_guid);
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+            hasMore = m_expiredMails->NextRow();
+        } while (hasMore);
 
-                delete resultItems;
-            }
+        //this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        //his in mailbox and he has already listed his mails )
+        if (serverUp && GetPlayer(MAKE_NEW_GUID(receiver, 0, HIGHGUID_PLAYER)))
+            continue;
+
+        //delete or return mail:
+        if (has_items)
+        {
             //if it is mail from AH, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || m->messageType == MAIL_AUCTION || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            if (messageType != MAIL_NORMAL || messageType == MAIL_AUCTION || (checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
                 // mail open and then not returned
-                for(std::vector<MailItemInfo>::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                    CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", itr2->item_guid);
+                for(std::vector<uint32>::const_iterator itr = itemGuids.begin(); itr != itemGuids.end(); ++itr)
+                {
+                    delItems << (hasDelItems ? "," : "") << *itr;
+                    hasDelItems = true;
+                }
             }
             else
             {
-                //mail will be returned:
-                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'", m->receiver, m->sender, (uint64)(basetime + 30*DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                delete m;
+                if (!inTransaction)
+                {
+                    CharacterDatabase.BeginTransaction();
+                    inTransaction = true;
+                }
+
+                //mail will be returned (only if still expired, not emptied and not returned or paid since query):
+                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' "
+                    "WHERE id = '%u' AND expire_time < '" UI64FMTD "' AND has_items <> '0' AND (checked & '%u') = '0'",
+                    receiver, sender, (uint64)(m_expiredMailsTime + 30*DAY), (uint64)m_expiredMailsTime, MAIL_CHECK_MASK_RETURNED,
+                    messageID, (uint64)m_expiredMailsTime, MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED);
                 continue;
             }
         }
 
-        //deletemail = true;
-        //delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
-        ++count;
-    } while (result->NextRow());
-    delete result;
+        delMails << (hasDelMails ? "," : "") << messageID;
+        hasDelMails = true;
+        ++m_expiredMailsCount;
+    }
+
+    if (!inTransaction && (hasDelItems || hasDelMails))
+    {
+        CharacterDatabase.BeginTransaction();
+        inTransaction = true;
+    }
+
+    // rows can be changed since query (item taken or mail returned by online receiver), delete only still expired ones
+    if (hasDelItems)
+        CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid IN (%s) AND guid IN "
+            "(SELECT item_guid FROM mail_items JOIN mail ON mail.id = mail_items.mail_id WHERE expire_time < '" UI64FMTD "')", delItems.str().c_str(), (uint64)m_expiredMailsTime);
+    if (hasDelMails)
+        CharacterDatabase.PExecute("DELETE FROM mail WHERE id IN (%s) AND expire_time < '" UI64FMTD "'", delMails.str().c_str(), (uint64)m_expiredMailsTime);
+
+    if (inTransaction)
+        CharacterDatabase.CommitTransaction();
+
+    if (!hasMore)
+    {
+        delete m_expiredMails;
+        m_expiredMails = NULL;
+
+        if (serverUp)
+            DETAIL_LOG("Expired mails processed, %u deleted", m_expiredMailsCount);
+    }
 
-    sLog.outString( ">> Loaded %u mails", count );
+    return hasMore;
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
@@ -5612,6 +5761,7 @@ uint32 ObjectMgr::GenerateLowGuid(HighGuid guidhigh)
 
 void ObjectMgr::LoadGameObjectLocales()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_GAMEOBJECT);
     mGameObjectLocaleMap.clear();                           // need for reload case
 
     QueryResult *result = WorldDatabase.Query("SELECT entry,"
@@ -5746,6 +5896,7 @@ inline void CheckGOConsumable(GameObjectInfo const* goInfo,uint32 dataN,uint32 N
 
 void ObjectMgr::LoadGameobjectInfo()
 {
+    sQueryResponseCache.Clear(QUERY_RESPONSE_GAMEOBJECT);
     SQLGameObjectLoader loader;
     loader.Load(sGOStorage);
 
@@ -6353,12 +6504,39 @@ void ObjectMgr::LoadWeatherZoneChances()
     sLog.outString(">> Loaded %u weather definitions", count);
 }
 
+time_t ObjectMgr::GetRespawnTime(RespawnTimes const& times, uint32 loguid, uint32 instance)
+{
+    RespawnTimes::const_iterator instItr = times.find(instance);
+    if (instItr == times.end())
+        return 0;
+
+    RespawnTimeMap::const_iterator itr = instItr->second.find(loguid);
+    return itr != instItr->second.end() ? itr->second : 0;
+}
+
+// 0 time removes spawn, so only really waiting spawns are stored
+void ObjectMgr::SetRespawnTime(RespawnTimes& times, uint32 loguid, uint32 instance, time_t t)
+{
+    if (t)
+    {
+        times[instance][loguid] = t;
+        return;
+    }
+
+    RespawnTimes::iterator instItr = times.find(instance);
+    if (instItr == times.end())
+        return;
+
+    instItr->second.erase(loguid);
+    if (instItr->second.empty())
+        times.erase(instItr);
+}
+
+// written to DB by SaveRespawnTimes, later save of same spawn replace not written one
 void ObjectMgr::SaveCreatureRespawnTime(uint32 loguid, uint32 instance, time_t t)
 {
-    mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
-    WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
-    if(t)
-        WorldDatabase.PExecute("INSERT INTO creature_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(t), instance);
+    SetRespawnTime(mCreatureRespawnTimes, loguid, instance, t);
+    mCreatureRespawnTimesToSave[instance][loguid] = t;
 }
 
 void ObjectMgr::DeleteCreatureData(uint32 guid)
@@ -6373,34 +6551,71 @@ void ObjectMgr::DeleteCreatureData(uint32 guid)
 
 void ObjectMgr::SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t)
 {
-    mGORespawnTimes[MAKE_PAIR64(loguid,instance)] = t;
-    WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE guid = '%u' AND instance = '%u'", loguid, instance);
-    if(t)
-        WorldDatabase.PExecute("INSERT INTO gameobject_respawn VALUES ( '%u', '" UI64FMTD "', '%u' )", loguid, uint64(t), instance);
+    SetRespawnTime(mGORespawnTimes, loguid, instance, t);
+    mGORespawnTimesToSave[instance][loguid] = t;
 }
 
-void ObjectMgr::DeleteRespawnTimeForInstance(uint32 instance)
-{
-    RespawnTimes::iterator next;
+// rows per DELETE/INSERT statement at respawn times save
+#define RESPAWN_TIMES_PER_STATEMENT 500
 
-    for(RespawnTimes::iterator itr = mGORespawnTimes.begin(); itr != mGORespawnTimes.end(); itr = next)
+void ObjectMgr::SaveRespawnTimes(RespawnTimes& toSave, char const* table)
+{
+    // grouped by instance already, so DELETE can use guid list for each instance
+    for(RespawnTimes::const_iterator instItr = toSave.begin(); instItr != toSave.end(); ++instItr)
     {
-        next = itr;
-        ++next;
+        uint32 instance = instItr->first;
+        RespawnTimeMap const& spawns = instItr->second;
 
-        if(GUID_HIPART(itr->first)==instance)
-            mGORespawnTimes.erase(itr);
-    }
+        RespawnTimeMap::const_iterator itr = spawns.begin();
+        while (itr != spawns.end())
+        {
+            std::ostringstream del, ins;
+            del << "DELETE FROM " << table << " WHERE instance = '" << instance << "' AND guid IN (";
+            ins << "INSERT INTO " << table << " VALUES ";
+            bool hasIns = false;
 
-    for(RespawnTimes::iterator itr = mCreatureRespawnTimes.begin(); itr != mCreatureRespawnTimes.end(); itr = next)
-    {
-        next = itr;
-        ++next;
+            for(uint32 i = 0; i < RESPAWN_TIMES_PER_STATEMENT && itr != spawns.end(); ++i, ++itr)
+            {
+                del << (i ? "," : "") << itr->first;
 
-        if(GUID_HIPART(itr->first)==instance)
-            mCreatureRespawnTimes.erase(itr);
+                // 0 only remove old time
+                if (!itr->second)
+                    continue;
+
+                ins << (hasIns ? "," : "") << "('" << itr->first << "', '" << uint64(itr->second) << "', '" << instance << "')";
+                hasIns = true;
+            }
+            del << ")";
+
+            WorldDatabase.Execute(del.str().c_str());
+            if (hasIns)
+                WorldDatabase.Execute(ins.str().c_str());
+        }
     }
 
+    toSave.clear();
+}
+
+void ObjectMgr::SaveRespawnTimes()
+{
+    if (mCreatureRespawnTimesToSave.empty() && mGORespawnTimesToSave.empty())
+        return;
+
+    WorldDatabase.BeginTransaction();
+    SaveRespawnTimes(mCreatureRespawnTimesToSave, "creature_respawn");
+    SaveRespawnTimes(mGORespawnTimesToSave, "gameobject_respawn");
+    WorldDatabase.CommitTransaction();
+}
+
+void ObjectMgr::DeleteRespawnTimeForInstance(uint32 instance)
+{
+    // not saved times also, DELETE below must be last write for instance
+    mCreatureRespawnTimesToSave.erase(instance);
+    mGORespawnTimesToSave.erase(instance);
+
+    mCreatureRespawnTimes.erase(instance);
+    mGORespawnTimes.erase(instance);
+
     WorldDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instance);
     WorldDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instance);
 }
@@ -6419,14 +6634,20 @@ void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_gui
 {
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
     CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(mapid,0)][cellid];
-    cell_guids.corpses[player_guid] = instance;
+    cell_guids.corpses[instance].insert(player_guid);
 }
 
-void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid)
+void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance)
 {
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
     CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(mapid,0)][cellid];
-    cell_guids.corpses.erase(player_guid);
+    CellCorpseSet::iterator itr = cell_guids.corpses.find(instance);
+    if (itr == cell_guids.corpses.end())
+        return;
+
+    itr->second.erase(player_guid);
+    if (itr->second.empty())
+        cell_guids.corpses.erase(itr);
 }
 
 void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map,char const* table)
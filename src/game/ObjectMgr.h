@@ -128,7 +128,7 @@ struct AreaTrigger
 };
 
 typedef std::set<uint32> CellGuidSet;
-typedef std::map<uint32/*player guid*/,uint32/*instance*/> CellCorpseSet;
+typedef std::map<uint32/*instance*/,CellGuidSet/*player guids*/> CellCorpseSet;
 struct CellObjectGuids
 {
     CellGuidSet creatures;
@@ -138,7 +138,8 @@ struct CellObjectGuids
 typedef UNORDERED_MAP<uint32/*cell_id*/,CellObjectGuids> CellObjectGuidsMap;
 typedef UNORDERED_MAP<uint32/*(mapid,spawnMode) pair*/,CellObjectGuidsMap> MapObjectGuids;
 
-typedef UNORDERED_MAP<uint64/*(instance,guid) pair*/,time_t> RespawnTimes;
+typedef UNORDERED_MAP<uint32/*guid*/,time_t> RespawnTimeMap;
+typedef UNORDERED_MAP<uint32/*instance*/,RespawnTimeMap> RespawnTimes;
 
 
 // String ranges
@@ -340,6 +341,20 @@ struct PlayerCondition
 };
 
 // NPC gossip text id
+// character data often requested for offline players, mirror of `characters` columns
+struct PlayerIdentity
+{
+    std::string name;                                       // empty for deleted characters kept in DB (CharDelete.Method 1)
+    uint32 account;
+    uint8 race;
+    uint8 class_;
+    uint8 gender;
+    uint8 level;
+};
+
+typedef UNORDERED_MAP<uint32/*lowguid*/, PlayerIdentity> PlayerIdentityMap;
+typedef std::map<std::string/*lower case name*/, uint32/*lowguid*/> PlayerNameIndexMap;
+
 typedef UNORDERED_MAP<uint32, uint32> CacheNpcTextIdMap;
 
 typedef UNORDERED_MAP<uint32, VendorItemData> CacheVendorItemMap;
@@ -527,6 +542,18 @@ class ObjectMgr
         uint32 GetPlayerAccountIdByGUID(const uint64 &guid) const;
         uint32 GetPlayerAccountIdByPlayerName(const std::string& name) const;
 
+        // kept current at character save, rename, customize and delete, used from world thread only
+        PlayerIdentity const* GetPlayerIdentity(uint32 lowguid) const
+        {
+            PlayerIdentityMap::const_iterator itr = mPlayerIdentities.find(lowguid);
+            return itr != mPlayerIdentities.end() ? &itr->second : NULL;
+        }
+        void SetPlayerIdentity(uint32 lowguid, std::string const& name, uint32 account, uint8 race, uint8 class_, uint8 gender, uint8 level);
+        void SetPlayerIdentityName(uint32 lowguid, std::string const& name);
+        void SetPlayerIdentityGender(uint32 lowguid, uint8 gender);
+        void SetPlayerIdentityLevel(uint32 lowguid, uint8 level);
+        void RemovePlayerIdentity(uint32 lowguid);
+
         uint32 GetNearestTaxiNode( float x, float y, float z, uint32 mapid, uint32 team );
         void GetTaxiPath( uint32 source, uint32 destination, uint32 &path, uint32 &cost);
         uint32 GetTaxiMountDisplayId( uint32 id, uint32 team, bool allowed_alt_team = false);
@@ -641,6 +668,7 @@ class ObjectMgr
         void LoadGameObjectLocales();
         void LoadGameobjects();
         void LoadGameobjectRespawnTimes();
+        void LoadPlayerIdentities();
         void LoadItemPrototypes();
         void LoadItemRequiredTarget();
         void LoadItemLocales();
@@ -703,6 +731,8 @@ class ObjectMgr
         }
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime);
+        bool UpdateExpiredMails(bool serverUp = true);      // process next chunk of expired mails, false if nothing left
 
         void SetHighestGuids();
         uint32 GenerateLowGuid(HighGuid guidhigh);
@@ -824,13 +854,14 @@ class ObjectMgr
         void SetDBCLocaleIndex(uint32 lang) { DBCLocaleIndex = GetIndexForLocale(LocaleConstant(lang)); }
 
         void AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance);
-        void DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid);
+        void DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance);
 
-        time_t GetCreatureRespawnTime(uint32 loguid, uint32 instance) { return mCreatureRespawnTimes[MAKE_PAIR64(loguid,instance)]; }
+        time_t GetCreatureRespawnTime(uint32 loguid, uint32 instance) const { return GetRespawnTime(mCreatureRespawnTimes, loguid, instance); }
         void SaveCreatureRespawnTime(uint32 loguid, uint32 instance, time_t t);
-        time_t GetGORespawnTime(uint32 loguid, uint32 instance) { return mGORespawnTimes[MAKE_PAIR64(loguid,instance)]; }
+        time_t GetGORespawnTime(uint32 loguid, uint32 instance) const { return GetRespawnTime(mGORespawnTimes, loguid, instance); }
         void SaveGORespawnTime(uint32 loguid, uint32 instance, time_t t);
         void DeleteRespawnTimeForInstance(uint32 instance);
+        void SaveRespawnTimes();                            // write changed respawn times to DB, called periodically and at shutdown
 
         // grid objects
         void AddCreatureToGrid(uint32 guid, CreatureData const* data);
@@ -1044,6 +1075,10 @@ class ObjectMgr
         void ConvertCreatureAddonAuras(CreatureDataAddon* addon, char const* table, char const* guidEntryStr);
         void ConvertCreatureAddonPassengers(CreatureDataAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelations& map,char const* table);
+        static std::string MakePlayerNameKey(std::string const& name);
+        void SaveRespawnTimes(RespawnTimes& toSave, char const* table);
+        static time_t GetRespawnTime(RespawnTimes const& times, uint32 loguid, uint32 instance);
+        static void SetRespawnTime(RespawnTimes& times, uint32 loguid, uint32 instance, time_t t);
 
         MailLevelRewardMap m_mailLevelRewardMap;
 
@@ -1083,6 +1118,16 @@ class ObjectMgr
         PointOfInterestLocaleMap mPointOfInterestLocaleMap;
         RespawnTimes mCreatureRespawnTimes;
         RespawnTimes mGORespawnTimes;
+        RespawnTimes mCreatureRespawnTimesToSave;           // changed since last SaveRespawnTimes, 0 time for delete
+        RespawnTimes mGORespawnTimesToSave;
+        PlayerIdentityMap mPlayerIdentities;
+        PlayerNameIndexMap mPlayerNameIndex;
+
+        // expired mail pass in progress
+        QueryResult* m_expiredMails;
+        time_t m_expiredMailsTime;
+        uint32 m_expiredMailsCount;
+        bool m_expiredMailsPending;                         // async query not returned yet
 
         // Storage for Conditions. First element (index 0) is reserved for zero-condition (nothing required)
         typedef std::vector<PlayerCondition> ConditionStore;
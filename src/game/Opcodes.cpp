@@ -1334,3 +1334,6 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x519*/ { "UMSG_UNKNOWN_1305",                            STATUS_NEVER,    &WorldSession::Handle_NULL                     },
     /*0x51A*/ { "UMSG_UNKNOWN_1306",                            STATUS_NEVER,    &WorldSession::Handle_NULL                     },
 };
+
+/// Filled by WorldSession::Update, shown and reset by .server opcodestats
+OpcodeStatistics opcodeStatistics[NUM_MSG_TYPES];
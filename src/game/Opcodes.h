@@ -1366,6 +1366,16 @@ struct OpcodeHandler
 
 extern OpcodeHandler opcodeTable[NUM_MSG_TYPES];
 
+/// Handler calls and time (in microseconds) for received opcode, updated by world thread
+struct OpcodeStatistics
+{
+    uint64 count;
+    uint64 totalTime;
+    uint32 maxTime;
+};
+
+extern OpcodeStatistics opcodeStatistics[NUM_MSG_TYPES];
+
 /// Lookup opcode name for human understandable logging
 inline const char* LookupOpcodeName(uint16 id)
 {
@@ -36,6 +36,7 @@ class DIAMOND_DLL_DECL PetAI : public CreatureAI
         void EnterEvadeMode();
         void AttackedBy(Unit*);
         bool IsVisible(Unit *) const;
+        uint32 GetLineOfSightInterest() const { return LOS_INTEREST_PLAYERS | LOS_INTEREST_HOSTILE_CREATURES; }
         void JustDied(Unit* /*who*/) { _stopAttack(); }
 
         void UpdateAI(const uint32);
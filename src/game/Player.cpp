@@ -2497,6 +2497,9 @@ void Player::GiveLevel(uint32 level)
 
     SetUInt32Value(PLAYER_NEXT_LEVEL_XP, sObjectMgr.GetXPForLevel(level));
 
+    if (Guild* guild = sObjectMgr.GetGuildById(GetGuildId()))
+        guild->UpdateRosterMemberLevel(GetGUIDLow(), level);
+
     //update level, max level of skills
     m_Played_time[PLAYED_TIME_LEVEL] = 0;                   // Level Played Time reset
 
@@ -3802,31 +3805,20 @@ Mail* Player::GetMail(uint32 id)
 
 void Player::_SetCreateBits(UpdateMask *updateMask, Player *target) const
 {
-    if(target == this)
-    {
-        Object::_SetCreateBits(updateMask, target);
-    }
-    else
-    {
-        for(uint16 index = 0; index < m_valuesCount; index++)
-        {
-            if(GetUInt32Value(index) != 0 && updateVisualBits.GetBit(index))
-                updateMask->SetBit(index);
-        }
-    }
+    Object::_SetCreateBits(updateMask, target);
+
+    // other players see only visible fields
+    if(target != this)
+        *updateMask &= updateVisualBits;
 }
 
 void Player::_SetUpdateBits(UpdateMask *updateMask, Player *target) const
 {
-    if(target == this)
-    {
-        Object::_SetUpdateBits(updateMask, target);
-    }
-    else
-    {
-        Object::_SetUpdateBits(updateMask, target);
+    Object::_SetUpdateBits(updateMask, target);
+
+    // other players see only visible fields
+    if(target != this)
         *updateMask &= updateVisualBits;
-    }
 }
 
 void Player::InitVisibleBits()
@@ -4231,11 +4223,14 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
             CharacterDatabase.PExecute("DELETE FROM guild_eventlog WHERE PlayerGuid1 = '%u' OR PlayerGuid2 = '%u'",guid, guid);
             CharacterDatabase.PExecute("DELETE FROM guild_bank_eventlog WHERE PlayerGuid = '%u'",guid);
             CharacterDatabase.CommitTransaction();
+            sObjectMgr.RemovePlayerIdentity(guid);
             break;
         }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
         case 1:
             CharacterDatabase.PExecute("UPDATE characters SET deleteInfos_Name=name, deleteInfos_Account=account, deleteDate='" UI64FMTD "', name='', account=0 WHERE guid=%u", uint64(time(NULL)), guid);
+            if (PlayerIdentity const* identity = sObjectMgr.GetPlayerIdentity(guid))
+                sObjectMgr.SetPlayerIdentity(guid, "", 0, identity->race, identity->class_, identity->gender, identity->level);
             break;
         default:
             sLog.outError("Player::DeleteFromDB: Unsupported delete method: %u.", charDelete_method);
@@ -6530,15 +6525,11 @@ uint32 Player::GetZoneIdFromDB(uint64 guid)
 
 uint32 Player::GetLevelFromDB(uint64 guid)
 {
-    QueryResult *result = CharacterDatabase.PQuery( "SELECT level FROM characters WHERE guid='%u'", GUID_LOPART(guid) );
-    if (!result)
-        return 0;
+    // cache mirrors the saved level
+    if (PlayerIdentity const* identity = sObjectMgr.GetPlayerIdentity(GUID_LOPART(guid)))
+        return identity->level;
 
-    Field* fields = result->Fetch();
-    uint32 level = fields[0].GetUInt32();
-    delete result;
-
-    return level;
+    return 0;
 }
 
 void Player::UpdateArea(uint32 newArea)
@@ -6585,6 +6576,9 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
                 Weather::SendFineWeatherUpdateToPlayer(this);
             }
         }
+
+        if (Guild* guild = sObjectMgr.GetGuildById(GetGuildId()))
+            guild->UpdateRosterMemberZone(GetGUIDLow(), newZone);
     }
 
     m_zoneUpdateId    = newZone;
@@ -16784,6 +16778,9 @@ void Player::SaveToDB()
 
     CharacterDatabase.CommitTransaction();
 
+    // also covers character creation and level changes
+    sObjectMgr.SetPlayerIdentity(GetGUIDLow(), m_name, GetSession()->GetAccountId(), getRace(), getClass(), getGender(), getLevel());
+
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
@@ -17332,6 +17329,7 @@ void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8
     player_bytes2 |= facialHair;
 
     CharacterDatabase.PExecute("UPDATE characters SET gender = '%u', playerBytes = '%u', playerBytes2 = '%u' WHERE guid = '%u'", gender, skin | (face << 8) | (hairStyle << 16) | (hairColor << 24), player_bytes2, GUID_LOPART(guid));
+    sObjectMgr.SetPlayerIdentityGender(GUID_LOPART(guid), gender);
 
     delete result;
 }
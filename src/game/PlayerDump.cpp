@@ -437,6 +437,9 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
     typedef PetIds::value_type PetIdsPair;
     PetIds petids;
 
+    std::string chrName;
+    uint8 chrRace = 0, chrClass = 0, chrGender = 0, chrLevel = 0;
+
     CharacterDatabase.BeginTransaction();
     while(!feof(fin))
     {
@@ -536,6 +539,11 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                     nameInvalidated = true;
                 }
 
+                chrName   = getnth(line, 3);                // characters.name
+                chrRace   = atoi(getnth(line, 4).c_str());  // characters.race
+                chrClass  = atoi(getnth(line, 5).c_str());  // characters.class
+                chrGender = atoi(getnth(line, 6).c_str());  // characters.gender
+                chrLevel  = atoi(getnth(line, 7).c_str());  // characters.level
                 break;
             }
             case DTT_INVENTORY:
@@ -674,6 +682,9 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     CharacterDatabase.CommitTransaction();
 
+    if (!chrName.empty())
+        sObjectMgr.SetPlayerIdentity(guid, chrName, account, chrRace, chrClass, chrGender, chrLevel);
+
     //FIXME: current code with post-updating guids not safe for future per-map threads
     sObjectMgr.m_ItemGuids.Set(sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed() + items.size());
     sObjectMgr.m_MailIds.Set(sObjectMgr.m_MailIds.GetNextAfterMaxUsed() +  mails.size());
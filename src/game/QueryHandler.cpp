@@ -32,6 +32,7 @@
 #include "NPCHandler.h"
 #include "Pet.h"
 #include "MapManager.h"
+#include "QueryResponseCache.h"
 
 void WorldSession::SendNameQueryOpcode(Player *p)
 {
@@ -60,14 +61,38 @@ void WorldSession::SendNameQueryOpcode(Player *p)
 
 void WorldSession::SendNameQueryOpcodeFromDB(uint64 guid)
 {
+    // declined names are not cached, only these need DB access
+    if (!sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
+    {
+        PlayerIdentity const* identity = sObjectMgr.GetPlayerIdentity(GUID_LOPART(guid));
+        if (!identity)
+            return;
+
+        std::string name = identity->name;
+        uint8 pRace = 0, pGender = 0, pClass = 0;
+        if (name.empty())
+            name         = GetString(LANG_NON_EXIST_CHARACTER);
+        else
+        {
+            pRace        = identity->race;
+            pGender      = identity->gender;
+            pClass       = identity->class_;
+        }
+                                                            // guess size
+        WorldPacket data( SMSG_NAME_QUERY_RESPONSE, (8+1+1+1+1+1+1+10) );
+        data.appendPackGUID(MAKE_NEW_GUID(GUID_LOPART(guid), 0, HIGHGUID_PLAYER));
+        data << uint8(0);                                   // added in 3.1; if > 1, then end of packet
+        data << name;
+        data << uint8(0);                                   // realm name for cross realm BG usage
+        data << uint8(pRace);                               // race
+        data << uint8(pGender);                             // gender
+        data << uint8(pClass);                              // class
+        data << uint8(0);                                   // is not declined
+        SendPacket( &data );
+        return;
+    }
+
     CharacterDatabase.AsyncPQuery(&WorldSession::SendNameQueryOpcodeFromDBCallBack, GetAccountId(),
-        !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
-    //   ------- Query Without Declined Names --------
-    //          0     1     2     3       4
-        "SELECT guid, name, race, gender, class "
-        "FROM characters WHERE guid = '%u'"
-        :
-    //   --------- Query With Declined Names ---------
     //          0                1     2     3       4
         "SELECT characters.guid, name, race, gender, class, "
     //   5         6       7           8             9
@@ -151,50 +176,10 @@ void WorldSession::HandleCreatureQueryOpcode( WorldPacket & recv_data )
     uint64 guid;
     recv_data >> guid;
 
-    CreatureInfo const *ci = ObjectMgr::GetCreatureTemplate(entry);
-    if (ci)
+    if (WorldPacket const* response = sQueryResponseCache.GetCreatureResponse(entry, GetSessionDbLocaleIndex()))
     {
-        std::string Name, SubName;
-        Name = ci->Name;
-        SubName = ci->SubName;
-
-        int loc_idx = GetSessionDbLocaleIndex();
-        if (loc_idx >= 0)
-        {
-            CreatureLocale const *cl = sObjectMgr.GetCreatureLocale(entry);
-            if (cl)
-            {
-                if (cl->Name.size() > size_t(loc_idx) && !cl->Name[loc_idx].empty())
-                    Name = cl->Name[loc_idx];
-                if (cl->SubName.size() > size_t(loc_idx) && !cl->SubName[loc_idx].empty())
-                    SubName = cl->SubName[loc_idx];
-            }
-        }
-        DETAIL_LOG("WORLD: CMSG_CREATURE_QUERY '%s' - Entry: %u.", ci->Name, entry);
-                                                            // guess size
-        WorldPacket data( SMSG_CREATURE_QUERY_RESPONSE, 100 );
-        data << uint32(entry);                              // creature entry
-        data << Name;
-        data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4, always empty
-        data << SubName;
-        data << ci->IconName;                               // "Directions" for guard, string for Icons 2.3.0
-        data << uint32(ci->type_flags);                     // flags
-        data << uint32(ci->type);                           // CreatureType.dbc
-        data << uint32(ci->family);                         // CreatureFamily.dbc
-        data << uint32(ci->rank);                           // Creature Rank (elite, boss, etc)
-        data << uint32(ci->KillCredit[0]);                  // new in 3.1, kill credit
-        data << uint32(ci->KillCredit[1]);                  // new in 3.1, kill credit
-        data << uint32(ci->DisplayID_A[0]);                 // modelid_male1
-        data << uint32(ci->DisplayID_H[0]);                 // modelid_female1 ?
-        data << uint32(ci->DisplayID_A[1]);                 // modelid_male2 ?
-        data << uint32(ci->DisplayID_H[1]);                 // modelid_femmale2 ?
-        data << float(ci->unk16);                           // unk
-        data << float(ci->unk17);                           // unk
-        data << uint8(ci->RacialLeader);
-        for(uint32 i = 0; i < 6; ++i)
-            data << uint32(ci->questItems[i]);              // itemId[6], quest drop
-        data << uint32(ci->movementId);                     // CreatureMovementInfo.dbc
-        SendPacket( &data );
+        DETAIL_LOG("WORLD: CMSG_CREATURE_QUERY - Entry: %u.", entry);
+        SendPacket( response );
         DEBUG_LOG( "WORLD: Sent SMSG_CREATURE_QUERY_RESPONSE" );
     }
     else
@@ -216,44 +201,10 @@ void WorldSession::HandleGameObjectQueryOpcode( WorldPacket & recv_data )
     uint64 guid;
     recv_data >> guid;
 
-    const GameObjectInfo *info = ObjectMgr::GetGameObjectInfo(entryID);
-    if(info)
+    if (WorldPacket const* response = sQueryResponseCache.GetGameObjectResponse(entryID, GetSessionDbLocaleIndex()))
     {
-        std::string Name;
-        std::string IconName;
-        std::string CastBarCaption;
-
-        Name = info->name;
-        IconName = info->IconName;
-        CastBarCaption = info->castBarCaption;
-
-        int loc_idx = GetSessionDbLocaleIndex();
-        if (loc_idx >= 0)
-        {
-            GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(entryID);
-            if (gl)
-            {
-                if (gl->Name.size() > size_t(loc_idx) && !gl->Name[loc_idx].empty())
-                    Name = gl->Name[loc_idx];
-                if (gl->CastBarCaption.size() > size_t(loc_idx) && !gl->CastBarCaption[loc_idx].empty())
-                    CastBarCaption = gl->CastBarCaption[loc_idx];
-            }
-        }
-        DETAIL_LOG("WORLD: CMSG_GAMEOBJECT_QUERY '%s' - Entry: %u. ", info->name, entryID);
-        WorldPacket data ( SMSG_GAMEOBJECT_QUERY_RESPONSE, 150 );
-        data << uint32(entryID);
-        data << uint32(info->type);
-        data << uint32(info->displayId);
-        data << Name;
-        data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4
-        data << IconName;                                   // 2.0.3, string. Icon name to use instead of default icon for go's (ex: "Attack" makes sword)
-        data << CastBarCaption;                             // 2.0.3, string. Text will appear in Cast Bar when using GO (ex: "Collecting")
-        data << info->unk1;                                 // 2.0.3, string
-        data.append(info->raw.data, 24);
-        data << float(info->size);                          // go size
-        for(uint32 i = 0; i < 6; ++i)
-            data << uint32(info->questItems[i]);            // itemId[6], quest drop
-        SendPacket( &data );
+        DETAIL_LOG("WORLD: CMSG_GAMEOBJECT_QUERY - Entry: %u. ", entryID);
+        SendPacket( response );
         DEBUG_LOG( "WORLD: Sent SMSG_GAMEOBJECT_QUERY_RESPONSE" );
     }
     else
@@ -329,13 +280,13 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
     recv_data >> guid;
     _player->SetTargetGUID(guid);
 
-    GossipText const* pGossip = sObjectMgr.GetGossipText(textID);
-
-    WorldPacket data( SMSG_NPC_TEXT_UPDATE, 100 );          // guess size
-    data << textID;
-
-    if (!pGossip)
+    if (WorldPacket const* response = sQueryResponseCache.GetNpcTextResponse(textID, GetSessionDbLocaleIndex()))
+        SendPacket( response );
+    else
     {
+        WorldPacket data( SMSG_NPC_TEXT_UPDATE, 100 );      // guess size
+        data << textID;
+
         for(uint32 i = 0; i < 8; ++i)
         {
             data << float(0);
@@ -349,58 +300,10 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
             data << uint32(0);
             data << uint32(0);
         }
-    }
-    else
-    {
-        std::string Text_0[8], Text_1[8];
-        for (int i = 0; i < 8; ++i)
-        {
-            Text_0[i]=pGossip->Options[i].Text_0;
-            Text_1[i]=pGossip->Options[i].Text_1;
-        }
-
-        int loc_idx = GetSessionDbLocaleIndex();
-        if (loc_idx >= 0)
-        {
-            NpcTextLocale const *nl = sObjectMgr.GetNpcTextLocale(textID);
-            if (nl)
-            {
-                for (int i = 0; i < 8; ++i)
-                {
-                    if (nl->Text_0[i].size() > size_t(loc_idx) && !nl->Text_0[i][loc_idx].empty())
-                        Text_0[i]=nl->Text_0[i][loc_idx];
-                    if (nl->Text_1[i].size() > size_t(loc_idx) && !nl->Text_1[i][loc_idx].empty())
-                        Text_1[i]=nl->Text_1[i][loc_idx];
-                }
-            }
-        }
-
-        for (int i = 0; i < 8; ++i)
-        {
-            data << pGossip->Options[i].Probability;
 
-            if ( Text_0[i].empty() )
-                data << Text_1[i];
-            else
-                data << Text_0[i];
-
-            if ( Text_1[i].empty() )
-                data << Text_0[i];
-            else
-                data << Text_1[i];
-
-            data << pGossip->Options[i].Language;
-
-            for(int j = 0; j < 3; ++j)
-            {
-                data << pGossip->Options[i].Emotes[j]._Delay;
-                data << pGossip->Options[i].Emotes[j]._Emote;
-            }
-        }
+        SendPacket( &data );
     }
 
-    SendPacket( &data );
-
     DEBUG_LOG( "WORLD: Sent SMSG_NPC_TEXT_UPDATE" );
 }
 
@@ -415,37 +318,22 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
 
     while (pageID)
     {
-        PageText const *pPage = sPageTextStore.LookupEntry<PageText>( pageID );
-                                                            // guess size
-        WorldPacket data( SMSG_PAGE_TEXT_QUERY_RESPONSE, 50 );
-        data << pageID;
+        if (WorldPacket const* response = sQueryResponseCache.GetPageTextResponse(pageID, GetSessionDbLocaleIndex()))
+        {
+            SendPacket( response );
 
-        if (!pPage)
+            PageText const *pPage = sPageTextStore.LookupEntry<PageText>( pageID );
+            pageID = pPage->Next_Page;
+        }
+        else
         {
+            WorldPacket data( SMSG_PAGE_TEXT_QUERY_RESPONSE, 50 );
+            data << pageID;
             data << "Item page missing.";
             data << uint32(0);
+            SendPacket( &data );
             pageID = 0;
         }
-        else
-        {
-            std::string Text = pPage->Text;
-
-            int loc_idx = GetSessionDbLocaleIndex();
-            if (loc_idx >= 0)
-            {
-                PageTextLocale const *pl = sObjectMgr.GetPageTextLocale(pageID);
-                if (pl)
-                {
-                    if (pl->Text.size() > size_t(loc_idx) && !pl->Text[loc_idx].empty())
-                        Text = pl->Text[loc_idx];
-                }
-            }
-
-            data << Text;
-            data << uint32(pPage->Next_Page);
-            pageID = pPage->Next_Page;
-        }
-        SendPacket( &data );
 
         DEBUG_LOG( "WORLD: Sent SMSG_PAGE_TEXT_QUERY_RESPONSE" );
     }
@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "QueryResponseCache.h"
+#include "Policies/SingletonImp.h"
+#include "WorldPacket.h"
+#include "Opcodes.h"
+#include "ObjectMgr.h"
+#include "DBCStores.h"
+
+INSTANTIATE_SINGLETON_1(QueryResponseCache);
+
+QueryResponseCache::QueryResponseCache()
+{
+}
+
+QueryResponseCache::~QueryResponseCache()
+{
+    for(int i = 0; i < MAX_QUERY_RESPONSE_TYPE; ++i)
+        Clear(QueryResponseType(i));
+}
+
+void QueryResponseCache::Clear(QueryResponseType type)
+{
+    for(ResponseMap::const_iterator itr = m_responses[type].begin(); itr != m_responses[type].end(); ++itr)
+        delete itr->second;
+
+    m_responses[type].clear();
+}
+
+WorldPacket const* QueryResponseCache::Find(QueryResponseType type, uint64 key) const
+{
+    ResponseMap::const_iterator itr = m_responses[type].find(key);
+    return itr != m_responses[type].end() ? itr->second : NULL;
+}
+
+WorldPacket const* QueryResponseCache::Store(QueryResponseType type, uint64 key, WorldPacket* data)
+{
+    if (data)
+        m_responses[type][key] = data;
+
+    return data;
+}
+
+WorldPacket const* QueryResponseCache::GetCreatureResponse(uint32 entry, int loc_idx)
+{
+    uint64 key = MakeKey(entry, loc_idx);
+    if (WorldPacket const* data = Find(QUERY_RESPONSE_CREATURE, key))
+        return data;
+
+    return Store(QUERY_RESPONSE_CREATURE, key, BuildCreatureResponse(entry, loc_idx));
+}
+
+WorldPacket const* QueryResponseCache::GetGameObjectResponse(uint32 entry, int loc_idx)
+{
+    uint64 key = MakeKey(entry, loc_idx);
+    if (WorldPacket const* data = Find(QUERY_RESPONSE_GAMEOBJECT, key))
+        return data;
+
+    return Store(QUERY_RESPONSE_GAMEOBJECT, key, BuildGameObjectResponse(entry, loc_idx));
+}
+
+WorldPacket const* QueryResponseCache::GetNpcTextResponse(uint32 textId, int loc_idx)
+{
+    uint64 key = MakeKey(textId, loc_idx);
+    if (WorldPacket const* data = Find(QUERY_RESPONSE_NPC_TEXT, key))
+        return data;
+
+    return Store(QUERY_RESPONSE_NPC_TEXT, key, BuildNpcTextResponse(textId, loc_idx));
+}
+
+WorldPacket const* QueryResponseCache::GetPageTextResponse(uint32 pageId, int loc_idx)
+{
+    uint64 key = MakeKey(pageId, loc_idx);
+    if (WorldPacket const* data = Find(QUERY_RESPONSE_PAGE_TEXT, key))
+        return data;
+
+    return Store(QUERY_RESPONSE_PAGE_TEXT, key, BuildPageTextResponse(pageId, loc_idx));
+}
+
+WorldPacket const* QueryResponseCache::GetItemResponse(uint32 entry, int loc_idx)
+{
+    uint64 key = MakeKey(entry, loc_idx);
+    if (WorldPacket const* data = Find(QUERY_RESPONSE_ITEM, key))
+        return data;
+
+    return Store(QUERY_RESPONSE_ITEM, key, BuildItemResponse(entry, loc_idx));
+}
+
+WorldPacket* QueryResponseCache::BuildCreatureResponse(uint32 entry, int loc_idx)
+{
+    CreatureInfo const *ci = ObjectMgr::GetCreatureTemplate(entry);
+    if (!ci)
+        return NULL;
+
+    std::string Name, SubName;
+    Name = ci->Name;
+    SubName = ci->SubName;
+
+    if (loc_idx >= 0)
+    {
+        CreatureLocale const *cl = sObjectMgr.GetCreatureLocale(entry);
+        if (cl)
+        {
+            if (cl->Name.size() > size_t(loc_idx) && !cl->Name[loc_idx].empty())
+                Name = cl->Name[loc_idx];
+            if (cl->SubName.size() > size_t(loc_idx) && !cl->SubName[loc_idx].empty())
+                SubName = cl->SubName[loc_idx];
+        }
+    }
+                                                            // guess size
+    WorldPacket* data = new WorldPacket( SMSG_CREATURE_QUERY_RESPONSE, 100 );
+    *data << uint32(entry);                                 // creature entry
+    *data << Name;
+    *data << uint8(0) << uint8(0) << uint8(0);              // name2, name3, name4, always empty
+    *data << SubName;
+    *data << ci->IconName;                                  // "Directions" for guard, string for Icons 2.3.0
+    *data << uint32(ci->type_flags);                        // flags
+    *data << uint32(ci->type);                              // CreatureType.dbc
+    *data << uint32(ci->family);                            // CreatureFamily.dbc
+    *data << uint32(ci->rank);                              // Creature Rank (elite, boss, etc)
+    *data << uint32(ci->KillCredit[0]);                     // new in 3.1, kill credit
+    *data << uint32(ci->KillCredit[1]);                     // new in 3.1, kill credit
+    *data << uint32(ci->DisplayID_A[0]);                    // modelid_male1
+    *data << uint32(ci->DisplayID_H[0]);                    // modelid_female1 ?
+    *data << uint32(ci->DisplayID_A[1]);                    // modelid_male2 ?
+    *data << uint32(ci->DisplayID_H[1]);                    // modelid_femmale2 ?
+    *data << float(ci->unk16);                              // unk
+    *data << float(ci->unk17);                              // unk
+    *data << uint8(ci->RacialLeader);
+    for(uint32 i = 0; i < 6; ++i)
+        *data << uint32(ci->questItems[i]);                 // itemId[6], quest drop
+    *data << uint32(ci->movementId);                        // CreatureMovementInfo.dbc
+    return data;
+}
+
+/// Only _static_ data send in this packet !!!
+WorldPacket* QueryResponseCache::BuildGameObjectResponse(uint32 entry, int loc_idx)
+{
+    const GameObjectInfo *info = ObjectMgr::GetGameObjectInfo(entry);
+    if (!info)
+        return NULL;
+
+    std::string Name;
+    std::string IconName;
+    std::string CastBarCaption;
+
+    Name = info->name;
+    IconName = info->IconName;
+    CastBarCaption = info->castBarCaption;
+
+    if (loc_idx >= 0)
+    {
+        GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(entry);
+        if (gl)
+        {
+            if (gl->Name.size() > size_t(loc_idx) && !gl->Name[loc_idx].empty())
+                Name = gl->Name[loc_idx];
+            if (gl->CastBarCaption.size() > size_t(loc_idx) && !gl->CastBarCaption[loc_idx].empty())
+                CastBarCaption = gl->CastBarCaption[loc_idx];
+        }
+    }
+
+    WorldPacket* data = new WorldPacket( SMSG_GAMEOBJECT_QUERY_RESPONSE, 150 );
+    *data << uint32(entry);
+    *data << uint32(info->type);
+    *data << uint32(info->displayId);
+    *data << Name;
+    *data << uint8(0) << uint8(0) << uint8(0);              // name2, name3, name4
+    *data << IconName;                                      // 2.0.3, string. Icon name to use instead of default icon for go's (ex: "Attack" makes sword)
+    *data << CastBarCaption;                                // 2.0.3, string. Text will appear in Cast Bar when using GO (ex: "Collecting")
+    *data << info->unk1;                                    // 2.0.3, string
+    data->append(info->raw.data, 24);
+    *data << float(info->size);                             // go size
+    for(uint32 i = 0; i < 6; ++i)
+        *data << uint32(info->questItems[i]);               // itemId[6], quest drop
+    return data;
+}
+
+WorldPacket* QueryResponseCache::BuildNpcTextResponse(uint32 textId, int loc_idx)
+{
+    GossipText const* pGossip = sObjectMgr.GetGossipText(textId);
+    if (!pGossip)
+        return NULL;
+
+    std::string Text_0[8], Text_1[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        Text_0[i]=pGossip->Options[i].Text_0;
+        Text_1[i]=pGossip->Options[i].Text_1;
+    }
+
+    if (loc_idx >= 0)
+    {
+        NpcTextLocale const *nl = sObjectMgr.GetNpcTextLocale(textId);
+        if (nl)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                if (nl->Text_0[i].size() > size_t(loc_idx) && !nl->Text_0[i][loc_idx].empty())
+                    Text_0[i]=nl->Text_0[i][loc_idx];
+                if (nl->Text_1[i].size() > size_t(loc_idx) && !nl->Text_1[i][loc_idx].empty())
+                    Text_1[i]=nl->Text_1[i][loc_idx];
+            }
+        }
+    }
+
+    WorldPacket* data = new WorldPacket( SMSG_NPC_TEXT_UPDATE, 100 );   // guess size
+    *data << textId;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        *data << pGossip->Options[i].Probability;
+
+        if ( Text_0[i].empty() )
+            *data << Text_1[i];
+        else
+            *data << Text_0[i];
+
+        if ( Text_1[i].empty() )
+            *data << Text_0[i];
+        else
+            *data << Text_1[i];
+
+        *data << pGossip->Options[i].Language;
+
+        for(int j = 0; j < 3; ++j)
+        {
+            *data << pGossip->Options[i].Emotes[j]._Delay;
+            *data << pGossip->Options[i].Emotes[j]._Emote;
+        }
+    }
+
+    return data;
+}
+
+WorldPacket* QueryResponseCache::BuildPageTextResponse(uint32 pageId, int loc_idx)
+{
+    PageText const *pPage = sPageTextStore.LookupEntry<PageText>( pageId );
+    if (!pPage)
+        return NULL;
+
+    std::string Text = pPage->Text;
+
+    if (loc_idx >= 0)
+    {
+        PageTextLocale const *pl = sObjectMgr.GetPageTextLocale(pageId);
+        if (pl)
+        {
+            if (pl->Text.size() > size_t(loc_idx) && !pl->Text[loc_idx].empty())
+                Text = pl->Text[loc_idx];
+        }
+    }
+                                                            // guess size
+    WorldPacket* data = new WorldPacket( SMSG_PAGE_TEXT_QUERY_RESPONSE, 50 );
+    *data << pageId;
+    *data << Text;
+    *data << uint32(pPage->Next_Page);
+    return data;
+}
+
+/// Only _static_ data send in this packet !!!
+WorldPacket* QueryResponseCache::BuildItemResponse(uint32 entry, int loc_idx)
+{
+    ItemPrototype const *pProto = ObjectMgr::GetItemPrototype( entry );
+    if (!pProto)
+        return NULL;
+
+    std::string Name        = pProto->Name1;
+    std::string Description = pProto->Description;
+
+    if ( loc_idx >= 0 )
+    {
+        ItemLocale const *il = sObjectMgr.GetItemLocale(pProto->ItemId);
+        if (il)
+        {
+            if (il->Name.size() > size_t(loc_idx) && !il->Name[loc_idx].empty())
+                Name = il->Name[loc_idx];
+            if (il->Description.size() > size_t(loc_idx) && !il->Description[loc_idx].empty())
+                Description = il->Description[loc_idx];
+        }
+    }
+                                                            // guess size
+    WorldPacket* data = new WorldPacket( SMSG_ITEM_QUERY_SINGLE_RESPONSE, 600);
+    *data << pProto->ItemId;
+    *data << pProto->Class;
+    *data << pProto->SubClass;
+    *data << int32(pProto->Unk0);                           // new 2.0.3, not exist in wdb cache?
+    *data << Name;
+    *data << uint8(0x00);                                   //pProto->Name2; // blizz not send name there, just uint8(0x00); <-- \0 = empty string = empty name...
+    *data << uint8(0x00);                                   //pProto->Name3; // blizz not send name there, just uint8(0x00);
+    *data << uint8(0x00);                                   //pProto->Name4; // blizz not send name there, just uint8(0x00);
+    *data << pProto->DisplayInfoID;
+    *data << pProto->Quality;
+    *data << pProto->Flags;
+    *data << pProto->Faction;                               // 3.2 faction?
+    *data << pProto->BuyPrice;
+    *data << pProto->SellPrice;
+    *data << pProto->InventoryType;
+    *data << pProto->AllowableClass;
+    *data << pProto->AllowableRace;
+    *data << pProto->ItemLevel;
+    *data << pProto->RequiredLevel;
+    *data << pProto->RequiredSkill;
+    *data << pProto->RequiredSkillRank;
+    *data << pProto->RequiredSpell;
+    *data << pProto->RequiredHonorRank;
+    *data << pProto->RequiredCityRank;
+    *data << pProto->RequiredReputationFaction;
+    *data << pProto->RequiredReputationRank;
+    *data << int32(pProto->MaxCount);
+    *data << int32(pProto->Stackable);
+    *data << pProto->ContainerSlots;
+    *data << pProto->StatsCount;                            // item stats count
+    for(uint32 i = 0; i < pProto->StatsCount; ++i)
+    {
+        *data << pProto->ItemStat[i].ItemStatType;
+        *data << pProto->ItemStat[i].ItemStatValue;
+    }
+    *data << pProto->ScalingStatDistribution;               // scaling stats distribution
+    *data << pProto->ScalingStatValue;                      // some kind of flags used to determine stat values column
+    for(int i = 0; i < MAX_ITEM_PROTO_DAMAGES; ++i)
+    {
+        *data << pProto->Damage[i].DamageMin;
+        *data << pProto->Damage[i].DamageMax;
+        *data << pProto->Damage[i].DamageType;
+    }
+
+    // resistances (7)
+    *data << pProto->Armor;
+    *data << pProto->HolyRes;
+    *data << pProto->FireRes;
+    *data << pProto->NatureRes;
+    *data << pProto->FrostRes;
+    *data << pProto->ShadowRes;
+    *data << pProto->ArcaneRes;
+
+    *data << pProto->Delay;
+    *data << pProto->AmmoType;
+    *data << pProto->RangedModRange;
+
+    for(int s = 0; s < MAX_ITEM_PROTO_SPELLS; ++s)
+    {
+        // send DBC data for cooldowns in same way as it used in Spell::SendSpellCooldown
+        // use `item_template` or if not set then only use spell cooldowns
+        SpellEntry const* spell = sSpellStore.LookupEntry(pProto->Spells[s].SpellId);
+        if(spell)
+        {
+            bool db_data = pProto->Spells[s].SpellCooldown >= 0 || pProto->Spells[s].SpellCategoryCooldown >= 0;
+
+            *data << pProto->Spells[s].SpellId;
+            *data << pProto->Spells[s].SpellTrigger;
+            *data << uint32(-abs(pProto->Spells[s].SpellCharges));
+
+            if(db_data)
+            {
+                *data << uint32(pProto->Spells[s].SpellCooldown);
+                *data << uint32(pProto->Spells[s].SpellCategory);
+                *data << uint32(pProto->Spells[s].SpellCategoryCooldown);
+            }
+            else
+            {
+                *data << uint32(spell->RecoveryTime);
+                *data << uint32(spell->Category);
+                *data << uint32(spell->CategoryRecoveryTime);
+            }
+        }
+        else
+        {
+            *data << uint32(0);
+            *data << uint32(0);
+            *data << uint32(0);
+            *data << uint32(-1);
+            *data << uint32(0);
+            *data << uint32(-1);
+        }
+    }
+    *data << pProto->Bonding;
+    *data << Description;
+    *data << pProto->PageText;
+    *data << pProto->LanguageID;
+    *data << pProto->PageMaterial;
+    *data << pProto->StartQuest;
+    *data << pProto->LockID;
+    *data << int32(pProto->Material);
+    *data << pProto->Sheath;
+    *data << pProto->RandomProperty;
+    *data << pProto->RandomSuffix;
+    *data << pProto->Block;
+    *data << pProto->ItemSet;
+    *data << pProto->MaxDurability;
+    *data << pProto->Area;
+    *data << pProto->Map;                                   // Added in 1.12.x & 2.0.1 client branch
+    *data << pProto->BagFamily;
+    *data << pProto->TotemCategory;
+    for(int s = 0; s < MAX_ITEM_PROTO_SOCKETS; ++s)
+    {
+        *data << pProto->Socket[s].Color;
+        *data << pProto->Socket[s].Content;
+    }
+    *data << uint32(pProto->socketBonus);
+    *data << uint32(pProto->GemProperties);
+    *data << int32(pProto->RequiredDisenchantSkill);
+    *data << float(pProto->ArmorDamageModifier);
+    *data << uint32(pProto->Duration);                      // added in 2.4.2.8209, duration (seconds)
+    *data << uint32(pProto->ItemLimitCategory);             // WotLK, ItemLimitCategory
+    *data << uint32(pProto->HolidayId);                     // Holiday.dbc?
+    return data;
+}
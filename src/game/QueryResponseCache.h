@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_QUERYRESPONSECACHE_H
+#define DIAMOND_QUERYRESPONSECACHE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Utilities/UnorderedMap.h"
+
+class WorldPacket;
+
+enum QueryResponseType
+{
+    QUERY_RESPONSE_CREATURE     = 0,                        // SMSG_CREATURE_QUERY_RESPONSE
+    QUERY_RESPONSE_GAMEOBJECT   = 1,                        // SMSG_GAMEOBJECT_QUERY_RESPONSE
+    QUERY_RESPONSE_NPC_TEXT     = 2,                        // SMSG_NPC_TEXT_UPDATE
+    QUERY_RESPONSE_PAGE_TEXT    = 3,                        // SMSG_PAGE_TEXT_QUERY_RESPONSE
+    QUERY_RESPONSE_ITEM         = 4                         // SMSG_ITEM_QUERY_SINGLE_RESPONSE
+};
+
+#define MAX_QUERY_RESPONSE_TYPE 5
+
+/**
+ * Ready to send responses for static data queries, built at first request for (entry, db locale index).
+ * Only existing entries are stored, so cache size is limited by DB content, not by client requests.
+ * Used from world thread only (session updates and .reload commands), so not locked.
+ */
+class QueryResponseCache
+{
+    public:
+        QueryResponseCache();
+        ~QueryResponseCache();
+
+        // NULL if entry not exist, returned packet valid until Clear() of same type
+        WorldPacket const* GetCreatureResponse(uint32 entry, int loc_idx);
+        WorldPacket const* GetGameObjectResponse(uint32 entry, int loc_idx);
+        WorldPacket const* GetNpcTextResponse(uint32 textId, int loc_idx);
+        WorldPacket const* GetPageTextResponse(uint32 pageId, int loc_idx);
+        WorldPacket const* GetItemResponse(uint32 entry, int loc_idx);
+
+        // called at (re)load of templates and locales used in responses of type, as cached responses are built from old data
+        void Clear(QueryResponseType type);
+
+    private:
+        typedef UNORDERED_MAP<uint64, WorldPacket*> ResponseMap;
+
+        static uint64 MakeKey(uint32 entry, int loc_idx) { return (uint64(loc_idx + 1) << 32) | entry; }
+
+        WorldPacket const* Find(QueryResponseType type, uint64 key) const;
+        WorldPacket const* Store(QueryResponseType type, uint64 key, WorldPacket* data);
+
+        static WorldPacket* BuildCreatureResponse(uint32 entry, int loc_idx);
+        static WorldPacket* BuildGameObjectResponse(uint32 entry, int loc_idx);
+        static WorldPacket* BuildNpcTextResponse(uint32 textId, int loc_idx);
+        static WorldPacket* BuildPageTextResponse(uint32 pageId, int loc_idx);
+        static WorldPacket* BuildItemResponse(uint32 entry, int loc_idx);
+
+        ResponseMap m_responses[MAX_QUERY_RESPONSE_TYPE];
+};
+
+#define sQueryResponseCache Diamond::Singleton<QueryResponseCache>::Instance()
+
+#endif
@@ -33,6 +33,7 @@ class DIAMOND_DLL_DECL ReactorAI : public CreatureAI
         void AttackStart(Unit *);
         void EnterEvadeMode();
         bool IsVisible(Unit *) const;
+        uint32 GetLineOfSightInterest() const { return LOS_INTEREST_NONE; }
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature *);
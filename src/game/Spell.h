@@ -417,7 +417,7 @@ class Spell
         void FillTargetMap();
         void SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList &targetUnitMap);
 
-        void FillAreaTargets(UnitList &targetUnitMap, float x, float y, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster = NULL);
+        void FillAreaTargets(UnitList &targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster = NULL);
         void FillRaidOrPartyTargets(UnitList &targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster);
         void FillRaidOrPartyManaPriorityTargets(UnitList &targetUnitMap, Unit* member, Unit* center, float radius, uint32 count, bool raid, bool withPets, bool withcaster);
         void FillRaidOrPartyHealthPriorityTargets(UnitList &targetUnitMap, Unit* member, Unit* center, float radius, uint32 count, bool raid, bool withPets, bool withcaster);
@@ -425,6 +425,7 @@ class Spell
         template<typename T> WorldObject* FindCorpseUsing();
 
         bool CheckTarget( Unit* target, SpellEffectIndex eff );
+        void PrefetchTargetsLineOfSight(UnitList const& targetUnitMap, SpellEffectIndex eff);
         bool CanAutoCast(Unit* target);
 
         static void DIAMOND_DLL_SPEC SendCastResult(Player* caster, SpellEntry const* spellInfo, uint8 cast_count, SpellCastResult result);
@@ -715,97 +716,132 @@ namespace Diamond
         }
 
         template<class T> inline void Visit(GridRefManager<T>  &m)
+        {
+            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                CheckTarget(itr->getSource());
+        }
+
+        // center and radius of push type for UnitPositionIndex search, units outside are never pushed
+        void GetSearchArea(float& x, float& y, float& radius) const
+        {
+            switch(i_push_type)
+            {
+                case PUSH_DEST_CENTER:
+                    x = i_spell.m_targets.m_destX;
+                    y = i_spell.m_targets.m_destY;
+                    radius = i_radius;
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (Unit* center = i_spell.m_targets.getUnitTarget())
+                    {
+                        x = center->GetPositionX();
+                        y = center->GetPositionY();
+                        radius = i_radius + center->GetObjectSize();
+                    }
+                    else
+                        radius = -1.0f;                     // nothing can be pushed
+                    break;
+                default:                                    // caster centered
+                    x = i_spell.GetCaster()->GetPositionX();
+                    y = i_spell.GetCaster()->GetPositionY();
+                    radius = i_radius + i_spell.GetCaster()->GetObjectSize();
+                    break;
+            }
+
+            // same reach limit as in Cell::Visit for grid searches
+            if (radius > 333.0f)
+                radius = 333.0f;
+        }
+
+        void CheckTarget(Unit* target)
         {
             ASSERT(i_data);
 
             if(!i_originalCaster)
                 return;
 
-            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                if ( (i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
-                    // mostly phase check
-                    || !itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            if ( (i_TargetType != SPELL_TARGETS_ALL && !target->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
+                // mostly phase check
+                || !target->IsInMap(i_originalCaster))
+                return;
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_HOSTILE:
+                    if (!i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_FRIENDLY:
+                    if (i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_HOSTILE:
+                    if (i_originalCaster->IsHostileTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_FRIENDLY:
+                    if (!i_originalCaster->IsFriendlyTo( target ))
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_DAMAGE:
                 {
-                    case SPELL_TARGETS_HOSTILE:
-                        if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_FRIENDLY:
-                        if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_HOSTILE:
-                        if (i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_FRIENDLY:
-                        if (!i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_DAMAGE:
+                    if(target->GetTypeId()==TYPEID_UNIT && ((Creature*)target)->isTotem())
+                        return;
+
+                    if (i_playerControled)
                     {
-                        if(itr->getSource()->GetTypeId()==TYPEID_UNIT && ((Creature*)itr->getSource())->isTotem())
-                            continue;
-
-                        if (i_playerControled)
-                        {
-                            if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                                continue;
-                        }
+                        if (i_originalCaster->IsFriendlyTo( target ))
+                            return;
+                    }
+                    else
+                    {
+                        if (!i_originalCaster->IsHostileTo( target ))
+                            return;
                     }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch(i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/2 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/6 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if(i_spell.GetCaster()->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/12 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if(i_spell.GetCaster()->isInBack((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if(i_spell.GetCaster()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if(itr->getSource()->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if(i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch(i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/2 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_30:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/6 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if(i_spell.GetCaster()->isInFront(target, i_radius, M_PI_F/12 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_BACK:
+                    if(i_spell.GetCaster()->isInBack(target, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_SELF_CENTER:
+                    if(i_spell.GetCaster()->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_DEST_CENTER:
+                    if(target->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if(i_spell.m_targets.getUnitTarget()->IsWithinDist(target, i_radius))
+                        i_data->push_back(target);
+                    break;
             }
         }
 
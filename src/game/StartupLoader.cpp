@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Threading.h"
+#include "Timer.h"
+#include "Log.h"
+#include <ace/Guard_T.h>
+
+class StartupLoader::LoadingThread : public ACE_Based::Runnable
+{
+    public:
+        explicit LoadingThread(StartupLoader& loader) : m_loader(loader) {}
+
+        void run()
+        {
+            WorldDatabase.ThreadStart();                    // let thread do safe mySQL requests (one connection call enough)
+
+            // without own connections queries are serialized with other threads, but still work
+            WorldDatabase.OpenThreadConnection();
+            CharacterDatabase.OpenThreadConnection();
+
+            m_loader.Work();
+
+            CharacterDatabase.CloseThreadConnection();
+            WorldDatabase.CloseThreadConnection();
+
+            WorldDatabase.ThreadEnd();                      // free mySQL thread resources
+        }
+
+    private:
+        StartupLoader& m_loader;
+};
+
+StartupLoader::StartupLoader() : m_stepFinished(m_lock), m_notFinished(0)
+{
+}
+
+uint32 StartupLoader::AddStep(char const* name, StartupLoadFunction function)
+{
+    Step step;
+    step.name = name;
+    step.function = function;
+    step.waitCount = 0;
+    m_steps.push_back(step);
+    return m_steps.size() - 1;
+}
+
+void StartupLoader::AddDependency(uint32 step, uint32 requiredStep)
+{
+    ASSERT(requiredStep < step && step < m_steps.size());
+
+    m_steps[requiredStep].dependents.push_back(step);
+    ++m_steps[step].waitCount;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 startTime = getMSTime();
+
+    if (threads <= 1)
+    {
+        for (uint32 id = 0; id < m_steps.size(); ++id)
+            LoadStep(id);
+    }
+    else
+    {
+        m_notFinished = m_steps.size();
+        for (uint32 id = 0; id < m_steps.size(); ++id)
+            if (!m_steps[id].waitCount)
+                m_ready.push_back(id);
+
+        // calling thread is used as one of loading threads
+        std::vector<ACE_Based::Thread*> loadingThreads;
+        for (uint32 i = 1; i < threads; ++i)
+            loadingThreads.push_back(new ACE_Based::Thread(new LoadingThread(*this)));
+
+        Work();
+
+        for (uint32 i = 0; i < loadingThreads.size(); ++i)
+        {
+            loadingThreads[i]->wait();
+            delete loadingThreads[i];
+        }
+    }
+
+    sLog.outString(">>> %u loading steps finished in %u ms (%u threads)", uint32(m_steps.size()), getMSTimeDiff(startTime, getMSTime()), threads > 1 ? threads : 1);
+    sLog.outString();
+}
+
+void StartupLoader::Work()
+{
+    uint32 id;
+    while (TakeStep(id))
+    {
+        LoadStep(id);
+        FinishStep(id);
+    }
+}
+
+bool StartupLoader::TakeStep(uint32& id)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    // steps still loading by other threads can make new steps ready
+    while (m_ready.empty() && m_notFinished)
+        m_stepFinished.wait();
+
+    if (m_ready.empty())
+        return false;
+
+    id = m_ready.front();
+    m_ready.pop_front();
+    return true;
+}
+
+void StartupLoader::FinishStep(uint32 id)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    Step& step = m_steps[id];
+    for (uint32 i = 0; i < step.dependents.size(); ++i)
+        if (!--m_steps[step.dependents[i]].waitCount)
+            m_ready.push_back(step.dependents[i]);
+
+    --m_notFinished;
+    m_stepFinished.broadcast();
+}
+
+void StartupLoader::LoadStep(uint32 id)
+{
+    Step const& step = m_steps[id];
+
+    sLog.outString("Loading %s...", step.name);
+
+    uint32 startTime = getMSTime();
+    (*step.function)();
+
+    sLog.outString(">>> %s loaded in %u ms", step.name, getMSTimeDiff(startTime, getMSTime()));
+    sLog.outString();
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_STARTUPLOADER_H
+#define DIAMOND_STARTUPLOADER_H
+
+#include "Common.h"
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <deque>
+#include <vector>
+
+typedef void (*StartupLoadFunction)();
+
+/**
+ * Runs startup loading steps with declared dependencies on several threads.
+ *
+ * A step can depend only on steps added before it, so declaration order is always
+ * a valid loading order and with one thread the steps run in that order in the
+ * calling thread. With more threads every loading thread (and the calling one) takes
+ * steps whose dependencies are finished; loading threads query world and character
+ * DB by own connections. Steps running at same time must not change data read by
+ * the other ones, such access is expressed by dependency.
+ */
+class StartupLoader
+{
+    public:
+        StartupLoader();
+
+        ///< Returns id of step used for AddDependency
+        uint32 AddStep(char const* name, StartupLoadFunction function);
+        ///< Step will be started only after requiredStep finished, requiredStep must be added before step
+        void AddDependency(uint32 step, uint32 requiredStep);
+
+        ///< Load all steps and return after last finished
+        void Run(uint32 threads);
+
+    private:
+        struct Step
+        {
+            char const* name;
+            StartupLoadFunction function;
+            std::vector<uint32> dependents;
+            uint32 waitCount;                               ///< not finished required steps
+        };
+
+        class LoadingThread;
+
+        void Work();                                        ///< run steps until all finished
+        bool TakeStep(uint32& id);
+        void FinishStep(uint32 id);
+        void LoadStep(uint32 id);
+
+        std::vector<Step> m_steps;
+
+        ACE_Thread_Mutex m_lock;                            ///< guards members below
+        ACE_Condition_Thread_Mutex m_stepFinished;
+        std::deque<uint32> m_ready;                         ///< not started steps with finished dependencies
+        uint32 m_notFinished;
+};
+#endif
@@ -26,6 +26,7 @@
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
 #include "Unit.h"
+#include "UnitPositionIndex.h"
 #include "QuestDef.h"
 #include "Player.h"
 #include "Creature.h"
@@ -171,6 +172,10 @@ Unit::Unit()
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
 
+    m_positionIndex = NULL;
+    m_positionIndexCell = 0;
+    m_positionIndexSlot = 0;
+
     m_updateFlag = (UPDATEFLAG_HIGHGUID | UPDATEFLAG_LIVING | UPDATEFLAG_HAS_POSITION);
 
     m_attackTimer[BASE_ATTACK]   = 0;
@@ -12069,6 +12074,9 @@ uint32 Unit::GetCreatePowers( Powers power ) const
 void Unit::AddToWorld()
 {
     Object::AddToWorld();
+
+    m_Events.SetTimerWheel(&GetMap()->GetEventTimerWheel());
+    GetMap()->GetUnitPositionIndex().Insert(this);
 }
 
 void Unit::RemoveFromWorld()
@@ -12084,6 +12092,11 @@ void Unit::RemoveFromWorld()
         CleanupDeletedAuras();
     }
 
+    // map can be changed or unloaded before next AddToWorld
+    m_Events.SetTimerWheel(NULL);
+    if (m_positionIndex)
+        m_positionIndex->Remove(this);
+
     Object::RemoveFromWorld();
 }
 
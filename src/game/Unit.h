@@ -302,6 +302,7 @@ class Item;
 class Pet;
 class PetAura;
 class Totem;
+class UnitPositionIndex;
 class Vehicle;
 
 struct SpellImmune
@@ -1943,6 +1944,12 @@ class DIAMOND_DLL_SPEC Unit : public WorldObject
         GuardianPetList m_guardianPets;
 
         uint64 m_TotemSlot[MAX_TOTEM_SLOT];
+
+        // entry in area search index of map, see UnitPositionIndex
+        friend class UnitPositionIndex;
+        UnitPositionIndex* m_positionIndex;
+        uint32 m_positionIndexCell;
+        uint32 m_positionIndexSlot;
 };
 
 template<typename Func>
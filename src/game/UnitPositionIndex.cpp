@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "UnitPositionIndex.h"
+#include "Unit.h"
+#include "GridDefines.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define UNIT_INDEX_SSE_RANGE_TEST
+    #include <xmmintrin.h>
+#endif
+
+#define UNIT_INDEX_NONE 0xFFFFFFFF
+
+// cell coordinate as in Diamond::ComputeCellPair, kept inside map for not valid positions
+static int32 GetCellCoord(float c)
+{
+    int32 val = int32((double(c) - CENTER_GRID_CELL_OFFSET) / SIZE_OF_GRID_CELL + CENTER_GRID_CELL_ID + 0.5);
+    if (val < 0)
+        return 0;
+    if (val >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return TOTAL_NUMBER_OF_CELLS_PER_MAP - 1;
+    return val;
+}
+
+UnitPositionIndex::UnitPositionIndex()
+{
+}
+
+UnitPositionIndex::~UnitPositionIndex()
+{
+    // units are removed from world before map is deleted, just don't leave dangling index pointers
+    for (CellMap::iterator itr = m_cells.begin(); itr != m_cells.end(); ++itr)
+        for (std::vector<Unit*>::iterator u_itr = itr->second.units.begin(); u_itr != itr->second.units.end(); ++u_itr)
+            (*u_itr)->m_positionIndex = NULL;
+}
+
+uint32 UnitPositionIndex::GetCellKey(float x, float y)
+{
+    return uint32(GetCellCoord(x)) * TOTAL_NUMBER_OF_CELLS_PER_MAP + uint32(GetCellCoord(y));
+}
+
+void UnitPositionIndex::Insert(Unit* unit)
+{
+    if (unit->m_positionIndex)
+        unit->m_positionIndex->Remove(unit);
+
+    unit->m_positionIndex = this;
+    AddToCell(unit, GetCellKey(unit->GetPositionX(), unit->GetPositionY()));
+}
+
+void UnitPositionIndex::Remove(Unit* unit)
+{
+    if (unit->m_positionIndex != this)
+        return;
+
+    RemoveFromCell(unit);
+    unit->m_positionIndex = NULL;
+}
+
+void UnitPositionIndex::Relocate(Unit* unit)
+{
+    if (unit->m_positionIndex != this)
+        return;
+
+    uint32 key = GetCellKey(unit->GetPositionX(), unit->GetPositionY());
+    if (key != unit->m_positionIndexCell)
+    {
+        RemoveFromCell(unit);
+        AddToCell(unit, key);
+        return;
+    }
+
+    CellUnits& cell = m_cells[key];
+    uint32 slot = unit->m_positionIndexSlot;
+    cell.x[slot] = unit->GetPositionX();
+    cell.y[slot] = unit->GetPositionY();
+}
+
+void UnitPositionIndex::UpdateObjectSize(Unit* unit)
+{
+    if (unit->m_positionIndex != this)
+        return;
+
+    CellUnits& cell = m_cells[unit->m_positionIndexCell];
+    uint32 slot = unit->m_positionIndexSlot;
+    if (cell.size[slot] == unit->GetObjectSize())
+        return;
+
+    m_objectSizes.erase(m_objectSizes.find(cell.size[slot]));
+    cell.size[slot] = unit->GetObjectSize();
+    m_objectSizes.insert(cell.size[slot]);
+}
+
+void UnitPositionIndex::AddToCell(Unit* unit, uint32 key)
+{
+    CellUnits& cell = m_cells[key];
+
+    unit->m_positionIndexCell = key;
+    unit->m_positionIndexSlot = cell.units.size();
+
+    cell.x.push_back(unit->GetPositionX());
+    cell.y.push_back(unit->GetPositionY());
+    cell.size.push_back(unit->GetObjectSize());
+    cell.units.push_back(unit);
+
+    m_objectSizes.insert(unit->GetObjectSize());
+}
+
+void UnitPositionIndex::RemoveFromCell(Unit* unit)
+{
+    CellMap::iterator itr = m_cells.find(unit->m_positionIndexCell);
+    ASSERT(itr != m_cells.end());
+
+    CellUnits& cell = itr->second;
+    uint32 slot = unit->m_positionIndexSlot;
+
+    m_objectSizes.erase(m_objectSizes.find(cell.size[slot]));
+
+    // last entry is moved into free slot
+    uint32 last = cell.units.size() - 1;
+    if (slot != last)
+    {
+        cell.x[slot] = cell.x[last];
+        cell.y[slot] = cell.y[last];
+        cell.size[slot] = cell.size[last];
+        cell.units[slot] = cell.units[last];
+        cell.units[slot]->m_positionIndexSlot = slot;
+    }
+
+    cell.x.pop_back();
+    cell.y.pop_back();
+    cell.size.pop_back();
+    cell.units.pop_back();
+
+    if (cell.units.empty())
+        m_cells.erase(itr);
+
+    unit->m_positionIndexCell = UNIT_INDEX_NONE;
+    unit->m_positionIndexSlot = UNIT_INDEX_NONE;
+}
+
+void UnitPositionIndex::GetUnitsInRange(float x, float y, float radius, std::vector<Unit*>& units) const
+{
+    if (m_objectSizes.empty())
+        return;
+
+    // cells with units up to radius plus largest object size in map
+    float cellRadius = radius + *m_objectSizes.rbegin();
+
+    int32 beginX = GetCellCoord(x - cellRadius);
+    int32 endX   = GetCellCoord(x + cellRadius);
+    int32 beginY = GetCellCoord(y - cellRadius);
+    int32 endY   = GetCellCoord(y + cellRadius);
+
+    // huge radius: less work to go through occupied cells only
+    if (uint32(endX - beginX + 1) * uint32(endY - beginY + 1) > m_cells.size())
+    {
+        for (CellMap::const_iterator itr = m_cells.begin(); itr != m_cells.end(); ++itr)
+        {
+            int32 cellX = int32(itr->first / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+            int32 cellY = int32(itr->first % TOTAL_NUMBER_OF_CELLS_PER_MAP);
+            if (cellX >= beginX && cellX <= endX && cellY >= beginY && cellY <= endY)
+                GetCellUnitsInRange(itr->second, x, y, radius, units);
+        }
+        return;
+    }
+
+    for (int32 cellX = beginX; cellX <= endX; ++cellX)
+    {
+        for (int32 cellY = beginY; cellY <= endY; ++cellY)
+        {
+            CellMap::const_iterator itr = m_cells.find(uint32(cellX) * TOTAL_NUMBER_OF_CELLS_PER_MAP + uint32(cellY));
+            if (itr != m_cells.end())
+                GetCellUnitsInRange(itr->second, x, y, radius, units);
+        }
+    }
+}
+
+void UnitPositionIndex::GetCellUnitsInRange(CellUnits const& cell, float x, float y, float radius, std::vector<Unit*>& units)
+{
+    uint32 count = cell.units.size();
+    uint32 i = 0;
+
+#ifdef UNIT_INDEX_SSE_RANGE_TEST
+    __m128 centerX = _mm_set1_ps(x);
+    __m128 centerY = _mm_set1_ps(y);
+    __m128 searchRadius = _mm_set1_ps(radius);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&cell.x[i]), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&cell.y[i]), centerY);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 maxDist = _mm_add_ps(_mm_loadu_ps(&cell.size[i]), searchRadius);
+        __m128 maxDistSq = _mm_mul_ps(maxDist, maxDist);
+
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, maxDistSq));
+        for (uint32 j = 0; mask; ++j, mask >>= 1)
+            if (mask & 1)
+                units.push_back(cell.units[i + j]);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = cell.x[i] - x;
+        float dy = cell.y[i] - y;
+        float maxDist = radius + cell.size[i];
+        if (dx * dx + dy * dy <= maxDist * maxDist)
+            units.push_back(cell.units[i]);
+    }
+}
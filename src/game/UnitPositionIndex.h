@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_UNITPOSITIONINDEX_H
+#define DIAMOND_UNITPOSITIONINDEX_H
+
+#include "Common.h"
+#include <vector>
+#include <set>
+
+class Unit;
+
+/**
+ * Positions of units in world of one map, packed per grid cell.
+ *
+ * Area searches test distance on the packed coordinates of all units in cells
+ * touched by the radius, so only units near enough are dereferenced for faction,
+ * phase and other checks. Units are added in AddToWorld, removed in RemoveFromWorld
+ * and their entries are moved at every WorldObject::Relocate and resized at every
+ * UNIT_FIELD_BOUNDINGRADIUS change.
+ */
+class UnitPositionIndex
+{
+    public:
+        UnitPositionIndex();
+        ~UnitPositionIndex();
+
+        void Insert(Unit* unit);
+        void Remove(Unit* unit);
+        void Relocate(Unit* unit);                          ///< coordinates of indexed unit changed
+        void UpdateObjectSize(Unit* unit);                  ///< object size of indexed unit changed
+
+        /// units with 2d distance to x,y not above radius plus their object size
+        void GetUnitsInRange(float x, float y, float radius, std::vector<Unit*>& units) const;
+
+    private:
+        struct CellUnits                                    ///< parallel arrays, coordinates are tested 4 at a time
+        {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> size;
+            std::vector<Unit*> units;
+        };
+
+        typedef UNORDERED_MAP<uint32, CellUnits> CellMap;
+
+        static uint32 GetCellKey(float x, float y);
+        void AddToCell(Unit* unit, uint32 key);
+        void RemoveFromCell(Unit* unit);
+        static void GetCellUnitsInRange(CellUnits const& cell, float x, float y, float radius, std::vector<Unit*>& units);
+
+        CellMap m_cells;
+        std::multiset<float> m_objectSizes;                 ///< sizes of indexed units, largest widens cells searched
+};
+
+#endif
@@ -22,31 +22,55 @@
 #include "UpdateFields.h"
 #include "Errors.h"
 
+#if COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define UPDATEMASK_USE_SSE2
+#  include <emmintrin.h>
+#endif
+
+// biggest values count of any object type, mask storage is kept inline to avoid heap allocation per update
+#define UPDATEMASK_MAX_BLOCKS ((PLAYER_END + 31) / 32)
+
 class UpdateMask
 {
     public:
-        UpdateMask( ) : mCount( 0 ), mBlocks( 0 ), mUpdateMask( 0 ) { }
-        UpdateMask( const UpdateMask& mask ) : mUpdateMask( 0 ) { *this = mask; }
-
-        ~UpdateMask( )
-        {
-            if(mUpdateMask)
-                delete [] mUpdateMask;
-        }
+        UpdateMask( ) : mCount( 0 ), mBlocks( 0 ) { }
+        UpdateMask( const UpdateMask& mask ) : mCount( 0 ), mBlocks( 0 ) { *this = mask; }
 
         void SetBit (uint32 index)
         {
-            ( (uint8 *)mUpdateMask )[ index >> 3 ] |= 1 << ( index & 0x7 );
+            mUpdateMask[ index >> 5 ] |= uint32(1) << ( index & 0x1F );
         }
 
         void UnsetBit (uint32 index)
         {
-            ( (uint8 *)mUpdateMask )[ index >> 3 ] &= (0xff ^ (1 <<  ( index & 0x7 ) ) );
+            mUpdateMask[ index >> 5 ] &= ~( uint32(1) << ( index & 0x1F ) );
         }
 
         bool GetBit (uint32 index) const
         {
-            return ( ( (uint8 *)mUpdateMask)[ index >> 3 ] & ( 1 << ( index & 0x7 ) )) != 0;
+            return ( mUpdateMask[ index >> 5 ] & ( uint32(1) << ( index & 0x1F ) ) ) != 0;
+        }
+
+        // returns index of first set bit at or after index, or GetCount() if none left
+        uint32 GetNextSetBit (uint32 index) const
+        {
+            uint32 block = index >> 5;
+            if (block >= mBlocks)
+                return mCount;
+
+            uint32 bits = mUpdateMask[block] & (0xFFFFFFFF << (index & 0x1F));
+            while (!bits)
+            {
+                if (++block >= mBlocks)
+                    return mCount;
+                bits = mUpdateMask[block];
+            }
+
+            return (block << 5) + CountTrailingZeros(bits);
         }
 
         uint32 GetBlockCount() const { return mBlocks; }
@@ -56,25 +80,52 @@ class UpdateMask
 
         void SetCount (uint32 valuesCount)
         {
-            if(mUpdateMask)
-                delete [] mUpdateMask;
+            ASSERT(valuesCount <= PLAYER_END);
 
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
 
-            mUpdateMask = new uint32[mBlocks];
             memset(mUpdateMask, 0, mBlocks << 2);
         }
 
         void Clear()
         {
-            if (mUpdateMask)
-                memset(mUpdateMask, 0, mBlocks << 2);
+            memset(mUpdateMask, 0, mBlocks << 2);
+        }
+
+        // set bits for all fields where values differ from mirror, a block at a time
+        void SetDifferentBits(const uint32* values, const uint32* mirror)
+        {
+            uint32 const fullBlocks = mCount >> 5;
+            for (uint32 block = 0; block < fullBlocks; ++block)
+                mUpdateMask[block] |= CompareBlock(values + (block << 5), mirror + (block << 5));
+
+            for (uint32 index = fullBlocks << 5; index < mCount; ++index)
+                if (values[index] != mirror[index])
+                    SetBit(index);
+        }
+
+        // set bits for all fields with non-zero value, a block at a time
+        void SetNonZeroBits(const uint32* values)
+        {
+            static const uint32 zeroBlock[32] = { 0 };
+
+            uint32 const fullBlocks = mCount >> 5;
+            for (uint32 block = 0; block < fullBlocks; ++block)
+                mUpdateMask[block] |= CompareBlock(values + (block << 5), zeroBlock);
+
+            for (uint32 index = fullBlocks << 5; index < mCount; ++index)
+                if (values[index] != 0)
+                    SetBit(index);
         }
 
         UpdateMask& operator = ( const UpdateMask& mask )
         {
-            SetCount(mask.mCount);
+            if (this == &mask)
+                return *this;
+
+            mCount = mask.mCount;
+            mBlocks = mask.mBlocks;
             memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
 
             return *this;
@@ -117,8 +168,44 @@ class UpdateMask
         }
 
     private:
+        static uint32 CountTrailingZeros(uint32 bits)
+        {
+#if COMPILER == COMPILER_MICROSOFT
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return uint32(index);
+#elif COMPILER == COMPILER_GNU
+            return uint32(__builtin_ctz(bits));
+#else
+            uint32 index = 0;
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        // returns 32 bit mask with bit i set if a[i] != b[i]
+        static uint32 CompareBlock(const uint32* a, const uint32* b)
+        {
+            uint32 bits = 0;
+#ifdef UPDATEMASK_USE_SSE2
+            for (uint32 i = 0; i < 32; i += 4)
+            {
+                __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+                bits |= uint32(~_mm_movemask_ps(_mm_castsi128_ps(eq)) & 0xF) << i;
+            }
+#else
+            for (uint32 i = 0; i < 32; ++i)
+                bits |= uint32(a[i] != b[i]) << i;
+#endif
+            return bits;
+        }
+
         uint32 mCount;
         uint32 mBlocks;
-        uint32 *mUpdateMask;
+        uint32 mUpdateMask[UPDATEMASK_MAX_BLOCKS];
 };
 #endif
@@ -39,7 +39,10 @@ void Vehicle::AddToWorld()
 {
     ///- Register the vehicle for guid lookup
     if(!IsInWorld())
+    {
         GetMap()->GetObjectsStore().insert<Vehicle>(GetGUID(), (Vehicle*)this);
+        GetMap()->GetCreatureEntryIndex().Insert(this);
+    }
 
     Unit::AddToWorld();
 }
@@ -48,7 +51,10 @@ void Vehicle::RemoveFromWorld()
 {
     ///- Remove the vehicle from the accessor
     if(IsInWorld())
+    {
         GetMap()->GetObjectsStore().erase<Vehicle>(GetGUID(), (Vehicle*)NULL);
+        GetMap()->GetCreatureEntryIndex().Remove(this);
+    }
 
     ///- Don't call the function for Creature, normal mobs + totems go in a different storage
     Unit::RemoveFromWorld();
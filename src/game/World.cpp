@@ -61,6 +61,7 @@
 #include "Util.h"
 #include "AuctionHouseBot.h"
 #include "CharacterDatabaseCleaner.h"
+#include "StartupLoader.h"
 
 INSTANTIATE_SINGLETON_1( World );
 
@@ -274,13 +275,7 @@ World::AddSession_ (WorldSession* s)
 
 int32 World::GetQueuePos(WorldSession* sess)
 {
-    uint32 position = 1;
-
-    for(Queue::const_iterator iter = m_QueuedPlayer.begin(); iter != m_QueuedPlayer.end(); ++iter, ++position)
-        if((*iter) == sess)
-            return position;
-
-    return 0;
+    return m_QueuedPlayer.GetPosition(sess);
 }
 
 void World::AddQueuedPlayer(WorldSession* sess)
@@ -305,25 +300,9 @@ bool World::RemoveQueuedPlayer(WorldSession* sess)
     // sessions count including queued to remove (if removed_session set)
     uint32 sessions = GetActiveSessionCount();
 
-    uint32 position = 1;
-    Queue::iterator iter = m_QueuedPlayer.begin();
-
-    // search to remove and count skipped positions
-    bool found = false;
-
-    for(;iter != m_QueuedPlayer.end(); ++iter, ++position)
-    {
-        if(*iter==sess)
-        {
-            sess->SetInQueue(false);
-            iter = m_QueuedPlayer.erase(iter);
-            found = true;                                   // removing queued session
-            break;
-        }
-    }
-
-    // iter point to next socked after removed or end()
-    // position store position of removed socket and then new position next socket after removed
+    bool found = m_QueuedPlayer.erase(sess);                // removing queued session
+    if (found)
+        sess->SetInQueue(false);
 
     // if session not queued then we need decrease sessions count
     if(!found && sessions)
@@ -345,20 +324,23 @@ bool World::RemoveQueuedPlayer(WorldSession* sess)
         pop_sess->SendTutorialsData();
 
         m_QueuedPlayer.pop_front();
-
-        // update iter to point first queued socket or end() if queue is empty now
-        iter = m_QueuedPlayer.begin();
-        position = 1;
     }
 
-    // update position from iter to end()
-    // iter point to first not updated socket, position store new position
-    for(; iter != m_QueuedPlayer.end(); ++iter, ++position)
-        (*iter)->SendAuthWaitQue(position);
-
+    // positions of sessions behind removed are sent later by SendQueuePositions
     return found;
 }
 
+void World::SendQueuePositions()
+{
+    LoginQueue::SessionList changed;
+    uint32 position;
+    if (!m_QueuedPlayer.GetChangedSessions(changed, position))
+        return;
+
+    for(LoginQueue::SessionList::const_iterator itr = changed.begin(); itr != changed.end(); ++itr, ++position)
+        (*itr)->SendAuthWaitQue(position);
+}
+
 /// Find a Weather object by the given zoneid
 Weather* World::FindWeather(uint32 id) const
 {
@@ -523,12 +505,24 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetGridCleanUpDelay(getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN));
 
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_DISTANCE, "GridPreloadDistance", 600);
+
+    setConfigMin(CONFIG_UINT32_LOADING_THREADS, "LoadingThreads", 1, 1);
+
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
+    setConfig(CONFIG_UINT32_INTERVAL_LOGIN_QUEUE, "PlayerLimit.QueueUpdateInterval", 5 * IN_MILLISECONDS);
+    if (reload)
+        m_timers[WUPDATE_LOGINQUEUE].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_LOGIN_QUEUE));
+
+    setConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE, "SaveRespawnTimeInterval", 10 * IN_MILLISECONDS);
+    if (reload)
+        m_timers[WUPDATE_RESPAWNTIMES].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE));
+
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
         setConfig(CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT);
 
@@ -731,6 +725,8 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_SESSION_MAX_PACKETS, "Network.MaxPacketsPerUpdate", 100);
+    setConfig(CONFIG_UINT32_SESSION_MAX_PACKET_TIME, "Network.MaxPacketTimePerUpdate", 20);
 
     if(int clientCacheId = sConfig.GetIntDefault("ClientCacheVersion", 0))
     {
@@ -847,18 +843,24 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s",m_dataPath.c_str());
     }
 
+    ///- Directory of binary copies of template tables, used while table not changed
+    if (!reload)
+        SQLStorage::SetCacheDirectory(sConfig.GetStringDefault("StorageCacheDir", ""));
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", 0);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
     std::string ignoreMapIds = sConfig.GetStringDefault("vmap.ignoreMapIds", "");
     std::string ignoreSpellIds = sConfig.GetStringDefault("vmap.ignoreSpellIds", "");
+    bool mapModelFiles = sConfig.GetBoolDefault("vmap.mapModelFiles", false);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapManager()->setEnableModelFileMapping(mapModelFiles);
     VMAP::VMapFactory::createOrGetVMapManager()->preventMapsFromBeingUsed(ignoreMapIds.c_str());
     VMAP::VMapFactory::preventSpellsFromBeingTestedForLoS(ignoreSpellIds.c_str());
     sLog.outString( "WORLD: VMap support included. LineOfSight:%i, getHeight:%i",enableLOS, enableHeight);
     sLog.outString( "WORLD: VMap data directory is: %svmaps",m_dataPath.c_str());
-    sLog.outString( "WORLD: VMap config keys are: vmap.enableLOS, vmap.enableHeight, vmap.ignoreMapIds, vmap.ignoreSpellIds");
+    sLog.outString( "WORLD: VMap config keys are: vmap.enableLOS, vmap.enableHeight, vmap.ignoreMapIds, vmap.ignoreSpellIds, vmap.mapModelFiles");
 
     /* AHBot Configuration Settings */
     setConfig(CONFIG_BOOL_AHBOT_SELLER_ENABLED  , "AuctionHouseBot.Seller.Enabled"  , false);
@@ -897,6 +899,174 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_AHBOT_TG_MAX_SKILL_RANK      , "AuctionHouseBot.Tradegoods.ReqSkill.Max"     , 0);
 }
 
+static void LoadLocalizationStrings()
+{
+    sObjectMgr.LoadCreatureLocales();
+    sObjectMgr.LoadGameObjectLocales();
+    sObjectMgr.LoadItemLocales();
+    sObjectMgr.LoadQuestLocales();
+    sObjectMgr.LoadNpcTextLocales();
+    sObjectMgr.LoadPageTextLocales();
+    sObjectMgr.LoadGossipMenuItemsLocales();
+    sObjectMgr.LoadPointOfInterestLocales();
+    sObjectMgr.SetDBCLocaleIndex(sWorld.GetDefaultDbcLocale()); // Get once for all the locale index of DBC language (console/broadcasts)
+}
+
+/// Startup loading steps, see dependencies in World::SetInitialWorldSettings
+static void LoadQuestsAndAreaTriggers()
+{
+    sObjectMgr.LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+
+    sLog.outString( "Loading Quest POI" );
+    sObjectMgr.LoadQuestPOI();
+
+    sLog.outString( "Loading Quests Relations..." );
+    sObjectMgr.LoadQuestRelations();                            // must be after quest load
+
+    sLog.outString( "Loading UNIT_NPC_FLAG_SPELLCLICK Data..." );
+    sObjectMgr.LoadNPCSpellClickSpells();
+
+    sLog.outString( "Loading SpellArea Data..." );          // must be after quest load
+    sSpellMgr.LoadSpellAreas();
+
+    sLog.outString( "Loading AreaTrigger definitions..." );
+    sObjectMgr.LoadAreaTriggerTeleports();                      // must be after item template load
+
+    sLog.outString( "Loading Quest Area Triggers..." );
+    sObjectMgr.LoadQuestAreaTriggers();                         // must be after LoadQuests
+
+    sLog.outString( "Loading Tavern Area Triggers..." );
+    sObjectMgr.LoadTavernAreaTriggers();
+
+    sLog.outString( "Loading AreaTrigger script names..." );
+    sObjectMgr.LoadAreaTriggerScripts();
+}
+
+static void LoadPlayerAndWorldInfo()
+{
+    sLog.outString( "Loading Graveyard-zone links...");
+    sObjectMgr.LoadGraveyardZones();
+
+    sLog.outString( "Loading Spell target coordinates..." );
+    sSpellMgr.LoadSpellTargetPositions();
+
+    sLog.outString( "Loading spell pet auras..." );
+    sSpellMgr.LoadSpellPetAuras();
+
+    sLog.outString( "Loading Player Create Info & Level Stats..." );
+    sObjectMgr.LoadPlayerInfo();
+
+    sLog.outString( "Loading Exploration BaseXP Data..." );
+    sObjectMgr.LoadExplorationBaseXP();
+
+    sLog.outString( "Loading Pet Name Parts..." );
+    sObjectMgr.LoadPetNames();
+
+    sLog.outString( "Loading pet level stats..." );
+    sObjectMgr.LoadPetLevelInfo();
+
+    sLog.outString( "Loading Player level dependent mail rewards..." );
+    sObjectMgr.LoadMailLevelRewards();
+
+    sLog.outString( "Loading Skill Fishing base level requirements..." );
+    sObjectMgr.LoadFishingBaseSkillLevel();
+
+    sLog.outString( "Loading BattleMasters..." );
+    sBattleGroundMgr.LoadBattleMastersEntry();
+
+    sLog.outString( "Loading BattleGround event indexes..." );
+    sBattleGroundMgr.LoadBattleEventIndexes();
+
+    sLog.outString( "Loading GameTeleports..." );
+    sObjectMgr.LoadGameTele();
+
+    sLog.outString( "Loading VehicleData..." );
+    sObjectMgr.LoadVehicleData();
+    sLog.outString( "Loading VehicleSeatData..." );
+    sObjectMgr.LoadVehicleSeatData();
+}
+
+static void LoadLootAndSkillTables()
+{
+    LoadLootTables();
+
+    sLog.outString( "Loading Skill Discovery Table..." );
+    LoadSkillDiscoveryTable();
+
+    sLog.outString( "Loading Skill Extra Item Table..." );
+    LoadSkillExtraItemTable();
+}
+
+static void LoadGameObjectsForQuests()
+{
+    sObjectMgr.LoadGameObjectForQuests();
+}
+
+static void LoadAchievements()
+{
+    sAchievementMgr.LoadAchievementReferenceList();
+    sAchievementMgr.LoadAchievementCriteriaList();
+    sAchievementMgr.LoadAchievementCriteriaRequirements();
+    sAchievementMgr.LoadRewards();
+    sAchievementMgr.LoadRewardLocales();
+    sAchievementMgr.LoadCompletedAchievements();
+}
+
+static void LoadVendorsAndTrainers()
+{
+    sObjectMgr.LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    sObjectMgr.LoadTrainerSpell();                              // must be after load CreatureTemplate
+}
+
+static void LoadGossip()
+{
+    sLog.outString( "Loading Npc Text Id..." );
+    sObjectMgr.LoadNpcTextId();                                 // must be after load Creature and NpcText
+
+    sLog.outString( "Loading Gossip scripts..." );
+    sObjectMgr.LoadGossipScripts();                             // must be before gossip menu options
+
+    sLog.outString( "Loading Gossip menus..." );
+    sObjectMgr.LoadGossipMenu();
+
+    sLog.outString( "Loading Gossip menu options..." );
+    sObjectMgr.LoadGossipMenuItems();
+}
+
+static void LoadWaypoints()
+{
+    sLog.outString( "Loading Waypoint scripts..." );            // before loading from creature_movement
+    sObjectMgr.LoadCreatureMovementScripts();
+
+    sWaypointMgr.Load();
+}
+
+static void LoadDatabaseScripts()
+{
+    sObjectMgr.LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+    sObjectMgr.LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+    sObjectMgr.LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
+    sObjectMgr.LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
+    sObjectMgr.LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
+}
+
+static void LoadScriptTexts()
+{
+    sObjectMgr.LoadDbScriptStrings();                           // must be after Load*Scripts calls
+}
+
+static void LoadCreatureEventAI()
+{
+    sLog.outString( "Loading CreatureEventAI Texts...");
+    sEventAIMgr.LoadCreatureEventAI_Texts(false);       // false, will checked in LoadCreatureEventAI_Scripts
+
+    sLog.outString( "Loading CreatureEventAI Summons...");
+    sEventAIMgr.LoadCreatureEventAI_Summons(false);     // false, will checked in LoadCreatureEventAI_Scripts
+
+    sLog.outString( "Loading CreatureEventAI Scripts...");
+    sEventAIMgr.LoadCreatureEventAI_Scripts();
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -970,17 +1140,7 @@ void World::SetInitialWorldSettings()
 
     sLog.outString();
     sLog.outString( "Loading Localization strings..." );
-    sObjectMgr.LoadCreatureLocales();
-    sObjectMgr.LoadGameObjectLocales();
-    sObjectMgr.LoadItemLocales();
-    sObjectMgr.LoadQuestLocales();
-    sObjectMgr.LoadNpcTextLocales();
-    sObjectMgr.LoadPageTextLocales();
-    sObjectMgr.LoadGossipMenuItemsLocales();
-    sObjectMgr.LoadPointOfInterestLocales();
-    sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog.outString( ">>> Localization strings loaded" );
-    sLog.outString();
+    LoadLocalizationStrings();
 
     sLog.outString( "Loading Page Texts..." );
     sObjectMgr.LoadPageTexts();
@@ -1078,96 +1238,60 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Loading Weather Data..." );
     sObjectMgr.LoadWeatherZoneChances();
 
-    sLog.outString( "Loading Quests..." );
-    sObjectMgr.LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog.outString( "Loading Quest POI" );
-    sObjectMgr.LoadQuestPOI();
-
-    sLog.outString( "Loading Quests Relations..." );
-    sLog.outString();
-    sObjectMgr.LoadQuestRelations();                            // must be after quest load
-    sLog.outString( ">>> Quests Relations loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading UNIT_NPC_FLAG_SPELLCLICK Data..." );
-    sObjectMgr.LoadNPCSpellClickSpells();
-
-    sLog.outString( "Loading SpellArea Data..." );          // must be after quest load
-    sSpellMgr.LoadSpellAreas();
-
-    sLog.outString( "Loading AreaTrigger definitions..." );
-    sObjectMgr.LoadAreaTriggerTeleports();                      // must be after item template load
-
-    sLog.outString( "Loading Quest Area Triggers..." );
-    sObjectMgr.LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    sLog.outString( "Loading Tavern Area Triggers..." );
-    sObjectMgr.LoadTavernAreaTriggers();
-
-    sLog.outString( "Loading AreaTrigger script names..." );
-    sObjectMgr.LoadAreaTriggerScripts();
+    CharacterDatabaseCleaner::CleanDatabase();
 
-    sLog.outString( "Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
+    sLog.outString( "Loading Character Identities..." );
+    sObjectMgr.LoadPlayerIdentities();
 
-    sLog.outString( "Loading Spell target coordinates..." );
-    sSpellMgr.LoadSpellTargetPositions();
+    sLog.outString( "Loading the max pet number..." );
+    sObjectMgr.LoadPetNumber();
 
-    sLog.outString( "Loading spell pet auras..." );
-    sSpellMgr.LoadSpellPetAuras();
+    sLog.outString( "Loading Player Corpses..." );
+    sObjectMgr.LoadCorpses();
 
-    sLog.outString( "Loading Player Create Info & Level Stats..." );
-    sLog.outString();
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString( ">>> Player Create Info & Level Stats loaded" );
+    ///- Load tables not changing data of each other, in parallel if enabled
+    ///  with one thread in order of steps, that is after corpses also for tables loaded before
+    ///  character tables earlier (battlemasters, teleports, vehicle data, gossip, waypoints, ...)
     sLog.outString();
+    StartupLoader loader;
 
-    sLog.outString( "Loading Exploration BaseXP Data..." );
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString( "Loading Pet Name Parts..." );
-    sObjectMgr.LoadPetNames();
+    uint32 quests       = loader.AddStep("Quests", &LoadQuestsAndAreaTriggers);
+    loader.AddStep("Player, pet and world info", &LoadPlayerAndWorldInfo);
 
-    CharacterDatabaseCleaner::CleanDatabase();
+    uint32 loot         = loader.AddStep("Loot Tables", &LoadLootAndSkillTables);
+    loader.AddDependency(loot, quests);                         // loot conditions checked against quests
 
-    sLog.outString( "Loading the max pet number..." );
-    sObjectMgr.LoadPetNumber();
+    uint32 goForQuests  = loader.AddStep("GameObjects for quests", &LoadGameObjectsForQuests);
+    loader.AddDependency(goForQuests, loot);
 
-    sLog.outString( "Loading pet level stats..." );
-    sObjectMgr.LoadPetLevelInfo();
+    uint32 achievements = loader.AddStep("Achievements", &LoadAchievements);
+    loader.AddDependency(achievements, quests);
 
-    sLog.outString( "Loading Player Corpses..." );
-    sObjectMgr.LoadCorpses();
+    uint32 vendors      = loader.AddStep("Vendors and Trainers", &LoadVendorsAndTrainers);
+    loader.AddDependency(vendors, quests);                      // spell click data set creature template npcflag
 
-    sLog.outString( "Loading Player level dependent mail rewards..." );
-    sObjectMgr.LoadMailLevelRewards();
+    uint32 gossip       = loader.AddStep("Gossip", &LoadGossip);
+    loader.AddDependency(gossip, quests);
+    loader.AddDependency(gossip, loot);                         // both add conditions
 
-    sLog.outString( "Loading Loot Tables..." );
-    sLog.outString();
-    LoadLootTables();
-    sLog.outString( ">>> Loot Tables loaded" );
-    sLog.outString();
+    // script tables of gossip, waypoints and scripts steps set flags of shared quests
+    uint32 waypoints    = loader.AddStep("Waypoints", &LoadWaypoints);
+    loader.AddDependency(waypoints, gossip);
 
-    sLog.outString( "Loading Skill Discovery Table..." );
-    LoadSkillDiscoveryTable();
+    uint32 scripts      = loader.AddStep("Scripts", &LoadDatabaseScripts);
+    loader.AddDependency(scripts, waypoints);
 
-    sLog.outString( "Loading Skill Extra Item Table..." );
-    LoadSkillExtraItemTable();
+    uint32 scriptTexts  = loader.AddStep("Scripts text locales", &LoadScriptTexts);
+    loader.AddDependency(scriptTexts, gossip);                  // texts of all script tables checked
+    loader.AddDependency(scriptTexts, waypoints);
+    loader.AddDependency(scriptTexts, scripts);
+    loader.AddDependency(scriptTexts, achievements);            // both add locale indexes
 
-    sLog.outString( "Loading Skill Fishing base level requirements..." );
-    sObjectMgr.LoadFishingBaseSkillLevel();
+    uint32 eventAI      = loader.AddStep("CreatureEventAI", &LoadCreatureEventAI);
+    loader.AddDependency(eventAI, quests);
+    loader.AddDependency(eventAI, scriptTexts);                 // both add strings to same string map
 
-    sLog.outString( "Loading Achievements..." );
-    sLog.outString();
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString( ">>> Achievements loaded" );
-    sLog.outString();
+    loader.Run(getConfig(CONFIG_UINT32_LOADING_THREADS));
 
     ///- Load dynamic data tables from the database
     sLog.outString( "Loading Auctions..." );
@@ -1189,43 +1313,6 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Loading ReservedNames..." );
     sObjectMgr.LoadReservedPlayersNames();
 
-    sLog.outString( "Loading GameObjects for quests..." );
-    sObjectMgr.LoadGameObjectForQuests();
-
-    sLog.outString( "Loading BattleMasters..." );
-    sBattleGroundMgr.LoadBattleMastersEntry();
-
-    sLog.outString( "Loading BattleGround event indexes..." );
-    sBattleGroundMgr.LoadBattleEventIndexes();
-
-    sLog.outString( "Loading GameTeleports..." );
-    sObjectMgr.LoadGameTele();
-
-    sLog.outString( "Loading Npc Text Id..." );
-    sObjectMgr.LoadNpcTextId();                                 // must be after load Creature and NpcText
-
-    sLog.outString( "Loading Gossip scripts..." );
-    sObjectMgr.LoadGossipScripts();                             // must be before gossip menu options
-
-    sLog.outString( "Loading Gossip menus..." );
-    sObjectMgr.LoadGossipMenu();
-
-    sLog.outString( "Loading Gossip menu options..." );
-    sObjectMgr.LoadGossipMenuItems();
-
-    sLog.outString( "Loading Vendors..." );
-    sObjectMgr.LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    sLog.outString( "Loading Trainers..." );
-    sObjectMgr.LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    sLog.outString( "Loading Waypoint scripts..." );            // before loading from creature_movement
-    sObjectMgr.LoadCreatureMovementScripts();
-
-    sLog.outString( "Loading Waypoints..." );
-    sLog.outString();
-    sWaypointMgr.Load();
-
     sLog.outString( "Loading GM tickets...");
     sObjectMgr.LoadTickets();
 
@@ -1233,34 +1320,6 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Returning old mails..." );
     sObjectMgr.ReturnOrDeleteOldMails(false);
 
-    ///- Load and initialize scripts
-    sLog.outString( "Loading Scripts..." );
-    sLog.outString();
-    sObjectMgr.LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr.LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr.LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr.LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr.LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sLog.outString( ">>> Scripts loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Scripts text locales..." );    // must be after Load*Scripts calls
-    sObjectMgr.LoadDbScriptStrings();
-
-    sLog.outString( "Loading VehicleData..." );
-    sObjectMgr.LoadVehicleData();
-    sLog.outString( "Loading VehicleSeatData..." );
-    sObjectMgr.LoadVehicleSeatData();
-
-    sLog.outString( "Loading CreatureEventAI Texts...");
-    sEventAIMgr.LoadCreatureEventAI_Texts(false);       // false, will checked in LoadCreatureEventAI_Scripts
-
-    sLog.outString( "Loading CreatureEventAI Summons...");
-    sEventAIMgr.LoadCreatureEventAI_Summons(false);     // false, will checked in LoadCreatureEventAI_Scripts
-
-    sLog.outString( "Loading CreatureEventAI Scripts...");
-    sEventAIMgr.LoadCreatureEventAI_Scripts();
-
     sLog.outString( "Initializing Scripts..." );
     if(!LoadScriptingModule())
         exit(1);
@@ -1289,6 +1348,8 @@ void World::SetInitialWorldSettings()
                                                             //Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(3*HOUR*IN_MILLISECONDS);
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY*IN_MILLISECONDS); // check for chars to delete every day
+    m_timers[WUPDATE_LOGINQUEUE].SetInterval(m_configUint32Values[CONFIG_UINT32_INTERVAL_LOGIN_QUEUE]);
+    m_timers[WUPDATE_RESPAWNTIMES].SetInterval(m_configUint32Values[CONFIG_UINT32_INTERVAL_RESPAWN_SAVE]);
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -1428,6 +1489,9 @@ void World::Update(uint32 diff)
         sAuctionMgr.Update();
     }
 
+    ///- Return or delete next part of expired mails found by last async mail query
+    sObjectMgr.UpdateExpiredMails();
+
     /// <li> Handle session updates when the timer has passed
     if (m_timers[WUPDATE_SESSIONS].Passed())
     {
@@ -1436,6 +1500,14 @@ void World::Update(uint32 diff)
         UpdateSessions(diff);
     }
 
+    /// <li> Send queue positions changed by logins and logouts since last time
+    if (m_timers[WUPDATE_LOGINQUEUE].Passed())
+    {
+        m_timers[WUPDATE_LOGINQUEUE].Reset();
+
+        SendQueuePositions();
+    }
+
     /// <li> Handle weather updates when the timer has passed
     if (m_timers[WUPDATE_WEATHERS].Passed())
     {
@@ -1477,6 +1549,14 @@ void World::Update(uint32 diff)
         sBattleGroundMgr.Update(diff);
     }
 
+    ///- Write respawn times changed by map updates since last save in one transaction
+    if (m_timers[WUPDATE_RESPAWNTIMES].Passed())
+    {
+        m_timers[WUPDATE_RESPAWNTIMES].Reset();
+
+        sObjectMgr.SaveRespawnTimes();
+    }
+
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
@@ -27,6 +27,7 @@
 #include "Timer.h"
 #include "Policies/Singleton.h"
 #include "SharedDefines.h"
+#include "LoginQueue.h"
 #include "ace/Atomic_Op.h"
 
 #include <map>
@@ -78,7 +79,9 @@ enum WorldTimers
     WUPDATE_CORPSES     = 5,
     WUPDATE_EVENTS      = 6,
     WUPDATE_DELETECHARS = 7,
-    WUPDATE_COUNT       = 8
+    WUPDATE_LOGINQUEUE  = 8,
+    WUPDATE_RESPAWNTIMES= 9,
+    WUPDATE_COUNT       = 10
 };
 
 /// Configuration elements
@@ -89,6 +92,12 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
+    CONFIG_UINT32_INTERVAL_LOGIN_QUEUE,
+    CONFIG_UINT32_INTERVAL_RESPAWN_SAVE,
+    CONFIG_UINT32_GRID_PRELOAD_DISTANCE,
+    CONFIG_UINT32_LOADING_THREADS,
+    CONFIG_UINT32_SESSION_MAX_PACKETS,
+    CONFIG_UINT32_SESSION_MAX_PACKET_TIME,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_SOCKET_SELECTTIME,
     CONFIG_UINT32_GAME_TYPE,
@@ -505,10 +514,11 @@ class World
         void SetPlayerLimit(int32 limit, bool needUpdate = false);
 
         //player Queue
-        typedef std::list<WorldSession*> Queue;
+        typedef LoginQueue Queue;
         void AddQueuedPlayer(WorldSession*);
         bool RemoveQueuedPlayer(WorldSession* session);
         int32 GetQueuePos(WorldSession*);
+        void SendQueuePositions();
         uint32 GetQueueSize() const { return m_QueuedPlayer.size(); }
 
         /// \todo Actions on m_allowMovement still to be implemented
@@ -162,9 +162,18 @@ bool WorldSession::Update(uint32 /*diff*/)
 {
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not proccess packets if socket already closed
+    /// packets over update budget are left in queue for next update, so single client can't hold world update
+    uint32 maxPackets = sWorld.getConfig(CONFIG_UINT32_SESSION_MAX_PACKETS);
+    uint32 maxTime = sWorld.getConfig(CONFIG_UINT32_SESSION_MAX_PACKET_TIME);
+    uint32 processed = 0;
+    uint32 startTime = getMSTime();
+
     WorldPacket* packet;
     while (m_Socket && !m_Socket->IsClosed() && _recvQueue.next(packet))
     {
+        uint16 opcode = packet->GetOpcode();
+        ACE_Time_Value handlerStart = ACE_OS::gettimeofday();
+
         /*#if 1
         sLog.outError( "MOEP: %s (0x%.4X)",
                         LookupOpcodeName(packet->GetOpcode()),
@@ -270,6 +279,18 @@ bool WorldSession::Update(uint32 /*diff*/)
         }
 
         delete packet;
+
+        ACE_Time_Value handlerTime = ACE_OS::gettimeofday() - handlerStart;
+        uint32 usec = uint32(handlerTime.sec() * 1000000 + handlerTime.usec());
+
+        OpcodeStatistics& stats = opcodeStatistics[opcode];
+        ++stats.count;
+        stats.totalTime += usec;
+        if (usec > stats.maxTime)
+            stats.maxTime = usec;
+
+        if ((maxPackets && ++processed >= maxPackets) || (maxTime && getMSTimeDiff(startTime, getMSTime()) >= maxTime))
+            break;
     }
 
     ///- Cleanup socket pointer if need
@@ -303,6 +303,9 @@ extern int main(int argc, char **argv)
     UnhookSignals();
 
     sLog.outString("Halting process...");
+
+    ///- Write queued log output before leaving
+    sLog.HaltWriterThread();
     return 0;
 }
 
@@ -7,67 +7,45 @@
 //return closest GO in grid, with range from pSource
 GameObject* GetClosestGameObjectWithEntry(WorldObject* pSource, uint32 uiEntry, float fMaxSearchRange)
 {
-    GameObject* pGo = NULL;
-
-    CellPair pair(Diamond::ComputeCellPair(pSource->GetPositionX(), pSource->GetPositionY()));
-    Cell cell(pair);
-    cell.data.Part.reserved = ALL_DISTRICT;
-    cell.SetNoCreate();
-
-    Diamond::NearestGameObjectEntryInObjectRangeCheck go_check(*pSource, uiEntry, fMaxSearchRange);
-    Diamond::GameObjectLastSearcher<Diamond::NearestGameObjectEntryInObjectRangeCheck> searcher(pSource, pGo, go_check);
-
-    TypeContainerVisitor<Diamond::GameObjectLastSearcher<Diamond::NearestGameObjectEntryInObjectRangeCheck>, GridTypeMapContainer> go_searcher(searcher);
-
-    cell.Visit(pair, go_searcher,*(pSource->GetMap()), *pSource, fMaxSearchRange);
-
-    return pGo;
+    return pSource->GetMap()->GetGameObjectEntryIndex().GetClosest(pSource, uiEntry, fMaxSearchRange);
 }
 
+struct CreatureAliveCheck
+{
+    bool operator() (Creature* pCreature) const { return pCreature->isAlive(); }
+};
+
 //return closest creature alive in grid, with range from pSource
 Creature* GetClosestCreatureWithEntry(WorldObject* pSource, uint32 uiEntry, float fMaxSearchRange)
 {
-    Creature* pCreature = NULL;
-
-    CellPair pair(Diamond::ComputeCellPair(pSource->GetPositionX(), pSource->GetPositionY()));
-    Cell cell(pair);
-    cell.data.Part.reserved = ALL_DISTRICT;
-    cell.SetNoCreate();
-
-    Diamond::NearestCreatureEntryWithLiveStateInObjectRangeCheck creature_check(*pSource, uiEntry, true, fMaxSearchRange);
-    Diamond::CreatureLastSearcher<Diamond::NearestCreatureEntryWithLiveStateInObjectRangeCheck> searcher(pSource, pCreature, creature_check);
-
-    TypeContainerVisitor<Diamond::CreatureLastSearcher<Diamond::NearestCreatureEntryWithLiveStateInObjectRangeCheck>, GridTypeMapContainer> creature_searcher(searcher);
-
-    cell.Visit(pair, creature_searcher,*(pSource->GetMap()), *pSource, fMaxSearchRange);
-
-    return pCreature;
+    CreatureAliveCheck check;
+    return pSource->GetMap()->GetCreatureEntryIndex().GetClosest(pSource, uiEntry, fMaxSearchRange, check);
 }
 
 void GetGameObjectListWithEntryInGrid(std::list<GameObject*>& lList , WorldObject* pSource, uint32 uiEntry, float fMaxSearchRange)
 {
-    CellPair pair(Diamond::ComputeCellPair(pSource->GetPositionX(), pSource->GetPositionY()));
-    Cell cell(pair);
-    cell.data.Part.reserved = ALL_DISTRICT;
-    cell.SetNoCreate();
+    MapEntryIndex<GameObject>::ObjectList const* pObjects = pSource->GetMap()->GetGameObjectEntryIndex().GetObjects(uiEntry);
+    if (!pObjects)
+        return;
 
     AllGameObjectsWithEntryInRange check(pSource, uiEntry, fMaxSearchRange);
-    Diamond::GameObjectListSearcher<AllGameObjectsWithEntryInRange> searcher(pSource, lList, check);
-    TypeContainerVisitor<Diamond::GameObjectListSearcher<AllGameObjectsWithEntryInRange>, GridTypeMapContainer> visitor(searcher);
-
-    cell.Visit(pair, visitor, *(pSource->GetMap()), *pSource, fMaxSearchRange);
+    for (MapEntryIndex<GameObject>::ObjectList::const_iterator itr = pObjects->begin(); itr != pObjects->end(); ++itr)
+    {
+        if (pSource->InSamePhase(*itr) && check(*itr))
+            lList.push_back(*itr);
+    }
 }
 
 void GetCreatureListWithEntryInGrid(std::list<Creature*>& lList, WorldObject* pSource, uint32 uiEntry, float fMaxSearchRange)
 {
-    CellPair pair(Diamond::ComputeCellPair(pSource->GetPositionX(), pSource->GetPositionY()));
-    Cell cell(pair);
-    cell.data.Part.reserved = ALL_DISTRICT;
-    cell.SetNoCreate();
+    MapEntryIndex<Creature>::ObjectList const* pObjects = pSource->GetMap()->GetCreatureEntryIndex().GetObjects(uiEntry);
+    if (!pObjects)
+        return;
 
     AllCreaturesOfEntryInRange check(pSource, uiEntry, fMaxSearchRange);
-    Diamond::CreatureListSearcher<AllCreaturesOfEntryInRange> searcher(pSource, lList, check);
-    TypeContainerVisitor<Diamond::CreatureListSearcher<AllCreaturesOfEntryInRange>, GridTypeMapContainer> visitor(searcher);
-
-    cell.Visit(pair, visitor, *(pSource->GetMap()), *pSource, fMaxSearchRange);
+    for (MapEntryIndex<Creature>::ObjectList::const_iterator itr = pObjects->begin(); itr != pObjects->end(); ++itr)
+    {
+        if (pSource->InSamePhase(*itr) && check(*itr))
+            lList.push_back(*itr);
+    }
 }
@@ -126,6 +126,11 @@ class DIAMOND_DLL_SPEC Database
         // must be called before finish thread run (one time for thread using one from existed Database objects)
         virtual void ThreadEnd();
 
+        // open own connection for queries of current thread instead of shared one, false if not supported
+        virtual bool OpenThreadConnection() { return false; }
+        // must be called before finish thread run if own connection opened
+        virtual void CloseThreadConnection() {}
+
         // sets the result queue of the current thread, be careful what thread you call this from
         void SetResultQueue(SqlResultQueue * queue);
 
@@ -75,17 +75,33 @@ bool DatabaseMysql::Initialize(const char *infoString)
         return false;
 
     tranThread = NULL;
+    mInfoString = infoString;
+
+    InitDelayThread();
+
+    mMysql = Connect(true);
+    if (!mMysql)
+        return false;
+
+    // set connection properties to UTF8 to properly handle locales for different
+    // server configs - core sends data in UTF8, so MySQL must expect UTF8 too
+    PExecute("SET NAMES `utf8`");
+    PExecute("SET CHARACTER SET `utf8`");
+
+    return true;
+}
+
+MYSQL* DatabaseMysql::Connect(bool logInfo)
+{
     MYSQL *mysqlInit;
     mysqlInit = mysql_init(NULL);
     if (!mysqlInit)
     {
         sLog.outError( "Could not initialize Mysql connection" );
-        return false;
+        return NULL;
     }
 
-    InitDelayThread();
-
-    Tokens tokens = StrSplit(infoString, ";");
+    Tokens tokens = StrSplit(mInfoString, ";");
 
     Tokens::iterator iter;
 
@@ -136,15 +152,18 @@ bool DatabaseMysql::Initialize(const char *infoString)
     }
     #endif
 
-    mMysql = mysql_real_connect(mysqlInit, host.c_str(), user.c_str(),
+    MYSQL *mysql = mysql_real_connect(mysqlInit, host.c_str(), user.c_str(),
         password.c_str(), database.c_str(), port, unix_socket, 0);
 
-    if (mMysql)
+    if (mysql)
     {
-        DETAIL_LOG( "Connected to MySQL database at %s",
-            host.c_str());
-        sLog.outString( "MySQL client library: %s", mysql_get_client_info());
-        sLog.outString( "MySQL server ver: %s ", mysql_get_server_info( mMysql));
+        if (logInfo)
+        {
+            DETAIL_LOG( "Connected to MySQL database at %s",
+                host.c_str());
+            sLog.outString( "MySQL client library: %s", mysql_get_client_info());
+            sLog.outString( "MySQL server ver: %s ", mysql_get_server_info( mysql));
+        }
 
         /*----------SET AUTOCOMMIT ON---------*/
         // It seems mysql 5.0.x have enabled this feature
@@ -154,26 +173,71 @@ bool DatabaseMysql::Initialize(const char *infoString)
         // This is wrong since DiamondCore use transactions,
         // autocommit is turned of during it.
         // Setting it to on makes atomic updates work
-        if (!mysql_autocommit(mMysql, 1))
+        if (!mysql_autocommit(mysql, 1))
             DETAIL_LOG("AUTOCOMMIT SUCCESSFULLY SET TO 1");
         else
             DETAIL_LOG("AUTOCOMMIT NOT SET TO 1");
         /*-------------------------------------*/
 
-        // set connection properties to UTF8 to properly handle locales for different
-        // server configs - core sends data in UTF8, so MySQL must expect UTF8 too
-        PExecute("SET NAMES `utf8`");
-        PExecute("SET CHARACTER SET `utf8`");
-
-        return true;
+        return mysql;
     }
     else
     {
         sLog.outError( "Could not connect to MySQL database at %s: %s\n",
             host.c_str(),mysql_error(mysqlInit));
         mysql_close(mysqlInit);
+        return NULL;
+    }
+}
+
+bool DatabaseMysql::OpenThreadConnection()
+{
+    if (!mMysql)
+        return false;
+
+    if (mThreadConnection->mysql)
+        return true;
+
+    MYSQL *mysql = Connect(false);
+    if (!mysql)
+        return false;
+
+    // not queued as PExecute, statements must be done before first query of thread
+    mysql_query(mysql, "SET NAMES `utf8`");
+    mysql_query(mysql, "SET CHARACTER SET `utf8`");
+
+    mThreadConnection->mysql = mysql;
+    return true;
+}
+
+void DatabaseMysql::CloseThreadConnection()
+{
+    if (!mThreadConnection->mysql)
+        return;
+
+    mysql_close(mThreadConnection->mysql);
+    mThreadConnection->mysql = NULL;
+}
+
+bool DatabaseMysql::_Query(MYSQL *mysql, const char *sql, MYSQL_RES **pResult, uint64* pRowCount, uint32* pFieldCount)
+{
+    uint32 _s = getMSTime();
+
+    if(mysql_query(mysql, sql))
+    {
+        sLog.outErrorDb( "SQL: %s", sql );
+        sLog.outErrorDb("query ERROR: %s", mysql_error(mysql));
         return false;
     }
+    else
+    {
+        DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", getMSTimeDiff(_s,getMSTime()), sql );
+    }
+
+    *pResult = mysql_store_result(mysql);
+    *pRowCount = mysql_affected_rows(mysql);
+    *pFieldCount = mysql_field_count(mysql);
+    return true;
 }
 
 bool DatabaseMysql::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount)
@@ -181,26 +245,19 @@ bool DatabaseMysql::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **p
     if (!mMysql)
         return 0;
 
+    if (MYSQL *threadMysql = mThreadConnection->mysql)
+    {
+        // own connection of thread, no lock needed
+        if (!_Query(threadMysql, sql, pResult, pRowCount, pFieldCount))
+            return false;
+    }
+    else
     {
         // guarded block for thread-safe mySQL request
         ACE_Guard<ACE_Thread_Mutex> query_connection_guard(mMutex);
 
-        uint32 _s = getMSTime();
-
-        if(mysql_query(mMysql, sql))
-        {
-            sLog.outErrorDb( "SQL: %s", sql );
-            sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+        if (!_Query(mMysql, sql, pResult, pRowCount, pFieldCount))
             return false;
-        }
-        else
-        {
-            DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", getMSTimeDiff(_s,getMSTime()), sql );
-        }
-
-        *pResult = mysql_store_result(mMysql);
-        *pRowCount = mysql_affected_rows(mMysql);
-        *pFieldCount = mysql_field_count(mMysql);
         // end guarded block
     }
 
@@ -26,6 +26,7 @@
 #include "Policies/Singleton.h"
 #include "ace/Thread_Mutex.h"
 #include "ace/Guard_T.h"
+#include "ace/TSS_T.h"
 
 #ifdef WIN32
 #include <winsock2.h>
@@ -64,17 +65,31 @@ class DIAMOND_DLL_SPEC DatabaseMysql : public Database
         void ThreadStart();
         // must be call before finish thread run
         void ThreadEnd();
+
+        bool OpenThreadConnection();
+        void CloseThreadConnection();
     private:
+        struct ThreadConnection
+        {
+            ThreadConnection() : mysql(NULL) {}
+            MYSQL *mysql;
+        };
+
         ACE_Thread_Mutex mMutex;
 
         ACE_Based::Thread * tranThread;
 
         MYSQL *mMysql;
 
+        std::string mInfoString;                            // for opening thread connections
+        ACE_TSS<ThreadConnection> mThreadConnection;        // own connection of thread, not guarded by mMutex
+
         static size_t db_count;
 
+        MYSQL* Connect(bool logInfo);
         bool _TransactionCmd(const char *sql);
         bool _Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount);
+        static bool _Query(MYSQL *mysql, const char *sql, MYSQL_RES **pResult, uint64* pRowCount, uint32* pFieldCount);
 };
 #endif
 #endif
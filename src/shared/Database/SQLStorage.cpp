@@ -49,6 +49,163 @@ SQLStorage sItemStorage(ItemPrototypesrcfmt, ItemPrototypedstfmt, "entry","item_
 SQLStorage sPageTextStore(PageTextfmt,"entry","page_text");
 SQLStorage sInstanceTemplate(InstanceTemplatesrcfmt, InstanceTemplatedstfmt, "map","instance_template");
 
+std::string SQLStorage::cacheDirectory;
+
+#define SQL_STORAGE_CACHE_MAGIC     0x434C5153              // "SQLC"
+#define SQL_STORAGE_CACHE_VERSION   1
+
+SQLStorageCache::SQLStorageCache(SQLStorage const& store) :
+    m_store(store), m_enabled(false), m_tableChecksum(0), m_maxEntry(0), m_recordCount(0), m_readPos(NULL)
+{
+    if (SQLStorage::GetCacheDirectory().empty())
+        return;
+
+#ifndef DO_POSTGRESQL
+    QueryResult *result = WorldDatabase.PQuery("CHECKSUM TABLE %s", store.GetTableName());
+    if (!result)
+        return;
+
+    Field *fields = result->Fetch();
+    // NULL checksum for not existed table
+    if (!fields[1].IsNULL())
+    {
+        m_tableChecksum = fields[1].GetUInt64();
+        m_enabled = true;
+    }
+    delete result;
+#endif
+}
+
+std::string SQLStorageCache::GetFileName() const
+{
+    std::string fileName = SQLStorage::GetCacheDirectory();
+    if (fileName.at(fileName.length()-1) != '/' && fileName.at(fileName.length()-1) != '\\')
+        fileName.append("/");
+    fileName.append(m_store.GetTableName());
+    fileName.append(".cache");
+    return fileName;
+}
+
+uint32 SQLStorageCache::Hash(char const* data, size_t size)
+{
+    // FNV-1a
+    uint32 hash = 2166136261U;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ uint8(data[i])) * 16777619U;
+    return hash;
+}
+
+bool SQLStorageCache::Load()
+{
+    if (!m_enabled)
+        return false;
+
+    std::string fileName = GetFileName();
+    if (m_map.map(fileName.c_str(), -1, O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+        return false;
+
+    char const* data = (char const*)m_map.addr();
+    size_t size = m_map.size();
+
+    std::string format = m_store.GetSrcFormat();
+    size_t headerSize = 4*sizeof(uint32) + sizeof(uint64) + format.length() + 3*sizeof(uint32);
+    if (!data || size < headerSize)
+        return false;
+
+    m_readPos = data;
+    uint32 magic = ReadUInt32();
+    uint32 version = ReadUInt32();
+    uint64 tableChecksum;
+    Read(&tableChecksum, sizeof(tableChecksum));
+    uint32 formatLength = ReadUInt32();
+    if (magic != SQL_STORAGE_CACHE_MAGIC || version != SQL_STORAGE_CACHE_VERSION ||
+        tableChecksum != m_tableChecksum || formatLength != format.length() ||
+        memcmp(m_readPos, format.c_str(), formatLength) != 0)
+    {
+        sLog.outDetail("Storage cache %s outdated, table %s will be loaded from DB", fileName.c_str(), m_store.GetTableName());
+        return false;
+    }
+    m_readPos += formatLength;
+
+    m_maxEntry = ReadUInt32();
+    m_recordCount = ReadUInt32();
+    uint32 dataSize = ReadUInt32();
+    uint32 dataHash = ReadUInt32();
+
+    if (!m_maxEntry || !m_recordCount || dataSize != size - headerSize || Hash(m_readPos, dataSize) != dataHash)
+    {
+        sLog.outError("Storage cache %s is damaged, table %s will be loaded from DB", fileName.c_str(), m_store.GetTableName());
+        return false;
+    }
+
+    return true;
+}
+
+char* SQLStorageCache::ReadString()
+{
+    uint32 length = ReadUInt32();
+    if (length == 0xFFFFFFFF)
+        return NULL;
+
+    char* str = const_cast<char*>(m_readPos);
+    m_readPos += length + 1;
+    return str;
+}
+
+void SQLStorageCache::WriteString(char const* str)
+{
+    if (!str)
+    {
+        WriteUInt32(0xFFFFFFFF);
+        return;
+    }
+
+    uint32 length = strlen(str);
+    WriteUInt32(length);
+    Write(str, length + 1);
+}
+
+void SQLStorageCache::Save(uint32 maxEntry, uint32 recordCount)
+{
+    if (!m_enabled)
+        return;
+
+    // outdated cache may be still mapped by Load()
+    m_map.close();
+
+    std::string fileName = GetFileName();
+    std::string tmpFileName = fileName + ".tmp";
+
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can't create storage cache file %s", tmpFileName.c_str());
+        return;
+    }
+
+    std::string format = m_store.GetSrcFormat();
+
+    uint32 header[2] = { SQL_STORAGE_CACHE_MAGIC, SQL_STORAGE_CACHE_VERSION };
+    uint32 formatLength = format.length();
+    uint32 counts[4] = { maxEntry, recordCount, uint32(m_writeData.size()), Hash(m_writeData.data(), m_writeData.size()) };
+
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+        fwrite(&m_tableChecksum, sizeof(m_tableChecksum), 1, file) == 1 &&
+        fwrite(&formatLength, sizeof(formatLength), 1, file) == 1 &&
+        fwrite(format.c_str(), formatLength, 1, file) == 1 &&
+        fwrite(counts, sizeof(counts), 1, file) == 1 &&
+        (m_writeData.empty() || fwrite(m_writeData.data(), m_writeData.size(), 1, file) == 1);
+    ok = fclose(file) == 0 && ok;
+
+    // replace old cache only by complete file
+    remove(fileName.c_str());
+    if (!ok || rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't write storage cache file %s", fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+}
+
 void SQLStorage::EraseEntry(uint32 id)
 {
     uint32 offset=0;
@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 
+class SQLStorageCache;
+
 class SQLStorage
 {
     template<class T>
@@ -64,6 +66,11 @@ class SQLStorage
         uint32 iNumFields;
 
         char const* GetTableName() const { return table; }
+        char const* GetSrcFormat() const { return src_format; }
+
+        // directory of table row caches, empty if disabled
+        static void SetCacheDirectory(std::string const& dir) { cacheDirectory = dir; }
+        static std::string const& GetCacheDirectory() { return cacheDirectory; }
 
         void Load();
         void Free();
@@ -88,6 +95,8 @@ class SQLStorage
         const char *table;
         const char *entry_field;
         //bool HasString;
+
+        static std::string cacheDirectory;
 };
 
 template <class T>
@@ -108,6 +117,9 @@ struct SQLStorageLoaderBase
         template<class V>
             void storeValue(V value, SQLStorage &store, char *p, int x, uint32 &offset);
         void storeValue(char * value, SQLStorage &store, char *p, int x, uint32 &offset);
+
+        void LoadFromCache(SQLStorage &store, SQLStorageCache &cache);
+        static uint32 GetRecordSize(SQLStorage const& store);
 };
 
 struct SQLStorageLoader : public SQLStorageLoaderBase<SQLStorageLoader>
@@ -18,6 +18,58 @@
 
 #include "Log.h"
 #include "DBCFileLoader.h"
+#include <ace/Mem_Map.h>
+
+/**
+ * On disk copy of table rows as read from DB (before loader conversions), used instead
+ * of the table while its CHECKSUM TABLE value is unchanged. Rows are stored per field
+ * in source format: int/float as 4 bytes, bool/byte as 1 byte, string as length
+ * (0xFFFFFFFF for NULL) followed by zero terminated text.
+ */
+class SQLStorageCache
+{
+    public:
+        explicit SQLStorageCache(SQLStorage const& store);
+
+        bool Load();                                        // map cache file, false if disabled, missing or outdated
+
+        uint32 GetMaxEntry() const { return m_maxEntry; }
+        uint32 GetRecordCount() const { return m_recordCount; }
+
+        // reading mapped rows
+        uint32 ReadUInt32() { uint32 v; Read(&v, sizeof(v)); return v; }
+        float ReadFloat() { float v; Read(&v, sizeof(v)); return v; }
+        uint8 ReadUInt8() { uint8 v; Read(&v, sizeof(v)); return v; }
+        char* ReadString();
+
+        // collecting rows read from DB, ignored if cache disabled
+        void WriteUInt32(uint32 v) { Write(&v, sizeof(v)); }
+        void WriteFloat(float v) { Write(&v, sizeof(v)); }
+        void WriteUInt8(uint8 v) { Write(&v, sizeof(v)); }
+        void WriteString(char const* str);
+        void Save(uint32 maxEntry, uint32 recordCount);
+
+    private:
+        void Read(void* dest, size_t size) { memcpy(dest, m_readPos, size); m_readPos += size; }
+        void Write(void const* src, size_t size)
+        {
+            if (m_enabled)
+                m_writeData.append((char const*)src, size);
+        }
+
+        std::string GetFileName() const;
+        static uint32 Hash(char const* data, size_t size);
+
+        SQLStorage const& m_store;
+        bool m_enabled;                                     // cache directory set and table checksum known
+        uint64 m_tableChecksum;
+        uint32 m_maxEntry;
+        uint32 m_recordCount;
+
+        ACE_Mem_Map m_map;
+        char const* m_readPos;
+        std::string m_writeData;
+};
 
 template<class T>
 template<class S, class D>
@@ -116,9 +168,73 @@ void SQLStorageLoaderBase<T>::storeValue(char * value, SQLStorage &store, char *
     }
 }
 
+template<class T>
+uint32 SQLStorageLoaderBase<T>::GetRecordSize(SQLStorage const& store)
+{
+    uint32 sc=0;
+    uint32 bo=0;
+    uint32 bb=0;
+    for(uint32 x=0; x< store.iNumFields; x++)
+        if(store.dst_format[x]==FT_STRING)
+            ++sc;
+        else if (store.dst_format[x]==FT_LOGIC)
+            ++bo;
+        else if (store.dst_format[x]==FT_BYTE)
+            ++bb;
+    return (store.iNumFields-sc-bo-bb)*4+sc*sizeof(char*)+bo*sizeof(bool)+bb*sizeof(char);
+}
+
+template<class T>
+void SQLStorageLoaderBase<T>::LoadFromCache(SQLStorage &store, SQLStorageCache &cache)
+{
+    uint32 maxi = cache.GetMaxEntry();
+    store.RecordCount = cache.GetRecordCount();
+
+    uint32 recordsize = GetRecordSize(store);
+
+    char** newIndex=new char*[maxi];
+    memset(newIndex,0,maxi*sizeof(char*));
+
+    char * _data= new char[store.RecordCount *recordsize];
+    for(uint32 count = 0; count < store.RecordCount; ++count)
+    {
+        char *p=(char*)&_data[recordsize*count];
+        newIndex[cache.ReadUInt32()]=p;
+
+        uint32 offset=0;
+        for(uint32 x = 0; x < store.iNumFields; x++)
+            switch(store.src_format[x])
+            {
+                case FT_LOGIC:
+                    storeValue((bool)(cache.ReadUInt8() > 0), store, p, x, offset); break;
+                case FT_BYTE:
+                    storeValue((char)cache.ReadUInt8(), store, p, x, offset); break;
+                case FT_INT:
+                    storeValue((uint32)cache.ReadUInt32(), store, p, x, offset); break;
+                case FT_FLOAT:
+                    storeValue((float)cache.ReadFloat(), store, p, x, offset); break;
+                case FT_STRING:
+                    storeValue(cache.ReadString(), store, p, x, offset); break;
+            }
+    }
+
+    store.pIndex = newIndex;
+    store.MaxEntry = maxi;
+    store.data = _data;
+
+    sLog.outDetail("Table %s loaded from storage cache", store.table);
+}
+
 template<class T>
 void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
 {
+    SQLStorageCache cache(store);
+    if (cache.Load())
+    {
+        LoadFromCache(store, cache);
+        return;
+    }
+
     uint32 maxi;
     Field *fields;
     QueryResult *result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.entry_field, store.table);
@@ -162,17 +278,7 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
     }
 
     //get struct size
-    uint32 sc=0;
-    uint32 bo=0;
-    uint32 bb=0;
-    for(uint32 x=0; x< store.iNumFields; x++)
-        if(store.dst_format[x]==FT_STRING)
-            ++sc;
-        else if (store.dst_format[x]==FT_LOGIC)
-            ++bo;
-        else if (store.dst_format[x]==FT_BYTE)
-            ++bb;
-    recordsize=(store.iNumFields-sc-bo-bb)*4+sc*sizeof(char*)+bo*sizeof(bool)+bb*sizeof(char);
+    recordsize=GetRecordSize(store);
 
     char** newIndex=new char*[maxi];
     memset(newIndex,0,maxi*sizeof(char*));
@@ -184,27 +290,50 @@ void SQLStorageLoaderBase<T>::Load(SQLStorage &store)
         fields = result->Fetch();
         char *p=(char*)&_data[recordsize*count];
         newIndex[fields[0].GetUInt32()]=p;
+        cache.WriteUInt32(fields[0].GetUInt32());
 
         offset=0;
         for(uint32 x = 0; x < store.iNumFields; x++)
             switch(store.src_format[x])
             {
                 case FT_LOGIC:
-                    storeValue((bool)(fields[x].GetUInt32() > 0), store, p, x, offset); break;
+                {
+                    bool value = fields[x].GetUInt32() > 0;
+                    cache.WriteUInt8(value ? 1 : 0);
+                    storeValue(value, store, p, x, offset); break;
+                }
                 case FT_BYTE:
-                    storeValue((char)fields[x].GetUInt8(), store, p, x, offset); break;
+                {
+                    char value = (char)fields[x].GetUInt8();
+                    cache.WriteUInt8(uint8(value));
+                    storeValue(value, store, p, x, offset); break;
+                }
                 case FT_INT:
-                    storeValue((uint32)fields[x].GetUInt32(), store, p, x, offset); break;
+                {
+                    uint32 value = fields[x].GetUInt32();
+                    cache.WriteUInt32(value);
+                    storeValue(value, store, p, x, offset); break;
+                }
                 case FT_FLOAT:
-                    storeValue((float)fields[x].GetFloat(), store, p, x, offset); break;
+                {
+                    float value = fields[x].GetFloat();
+                    cache.WriteFloat(value);
+                    storeValue(value, store, p, x, offset); break;
+                }
                 case FT_STRING:
-                    storeValue((char*)fields[x].GetString(), store, p, x, offset); break;
+                {
+                    char* value = (char*)fields[x].GetString();
+                    cache.WriteString(value);
+                    storeValue(value, store, p, x, offset); break;
+                }
             }
         ++count;
     }while( result->NextRow() );
 
     delete result;
 
+    cache.Save(maxi, count);
+
     store.pIndex = newIndex;
     store.MaxEntry = maxi;
     store.data = _data;
@@ -18,6 +18,8 @@
 
 #include "Common.h"
 #include "Log.h"
+#include "LogWriter.h"
+#include "PacketCapture.h"
 #include "Policies/SingletonImp.h"
 #include "Config/ConfigEnv.h"
 #include "Util.h"
@@ -28,6 +30,7 @@
 #include <iostream>
 
 #include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_time.h"
 
 INSTANTIATE_SINGLETON_1( Log );
 
@@ -59,9 +62,25 @@ enum LogType
 
 const int LogType_count = int(LogError) +1;
 
+// binary capture data is little endian on every platform
+template<class T>
+static void appendLE(std::string& buf, T value)
+{
+    EndianConvert(value);
+    buf.append((char const*)&value, sizeof(T));
+}
+
+/// opcodes with name chunk already written by a thread, sized up to highest opcode seen
+struct PacketCaptureNames
+{
+    std::vector<uint8> named;
+};
+
 Log::Log() :
     raLogfile(NULL), logfile(NULL), gmLogfile(NULL), charLogfile(NULL),
-    dberLogfile(NULL), m_colored(false), m_includeTime(false), m_gmlog_per_account(false)
+    dberLogfile(NULL), m_colored(false), m_includeTime(false), m_gmlog_per_account(false),
+    m_asyncOutput(false), m_writerBody(NULL), m_writerThread(NULL),
+    m_packetCaptureNames(new ACE_TSS<PacketCaptureNames>)
 {
     Initialize();
 }
@@ -258,7 +277,17 @@ void Log::Initialize()
     charLogfile = openLogFile("CharLogFile","CharLogTimestamp","a");
     dberLogfile = openLogFile("DBErrorLogFile",NULL,"a");
     raLogfile = openLogFile("RaLogFile",NULL,"a");
-    worldLogfile = openLogFile("WorldLogFile","WorldLogTimestamp","a");
+    worldLogfile = openLogFile("WorldLogFile","WorldLogTimestamp","ab");
+    if (worldLogfile)
+    {
+        std::string header;
+        appendLE(header, uint8(PACKET_CAPTURE_SESSION));
+        header.append(PACKET_CAPTURE_MAGIC, 4);
+        appendLE(header, uint16(PACKET_CAPTURE_VERSION));
+
+        fwrite(header.data(), 1, header.size(), worldLogfile);
+        fflush(worldLogfile);
+    }
 
     // Main log file settings
     m_includeTime  = sConfig.GetBoolDefault("LogTime", false);
@@ -274,6 +303,11 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // Background output settings
+    m_asyncOutput = sConfig.GetBoolDefault("LogAsync", false);
+    if (m_asyncOutput)
+        InitWriterThread(sConfig.GetIntDefault("LogAsync.QueueSize", 4096), sConfig.GetIntDefault("LogAsync.FlushInterval", 0));
 }
 
 FILE* Log::openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode)
@@ -304,6 +338,31 @@ FILE* Log::openGmlogPerAccount(uint32 account)
     return fopen(namebuf, "a");
 }
 
+void Log::InitWriterThread(uint32 queueSize, uint32 flushInterval)
+{
+    if (m_writerThread)
+        return;
+
+    m_writerBody = new LogWriter(queueSize, flushInterval);
+    // body outlives the thread: exited threads may still close their rings in it
+    m_writerBody->incReference();
+    m_writerThread = new ACE_Based::Thread(m_writerBody);
+}
+
+void Log::HaltWriterThread()
+{
+    if (!m_writerBody || !m_writerThread)
+        return;
+
+    m_writerBody->Stop();                                   //Stop event, later output is synchronous
+    m_writerThread->wait();                                 //Wait for write queued output
+    delete m_writerThread;
+    m_writerThread = NULL;
+
+    // records queued by other threads while writer was exiting
+    m_writerBody->Drain();
+}
+
 void Log::outTimestamp(FILE* file)
 {
     time_t t = time(NULL);
@@ -345,81 +404,174 @@ std::string Log::GetTimestampStr()
     return std::string(buf);
 }
 
-void Log::outTitle( const char * str)
+// format once, the text is used for console and file output (and maybe for other thread)
+static void vformat(std::string& out, const char* str, va_list ap)
 {
-    if (!str)
+    char buf[1024];
+
+    va_list ap2;
+    va_copy(ap2, ap);
+    int len = vsnprintf(buf, sizeof(buf), str, ap2);
+    va_end(ap2);
+
+    if (len >= 0 && len < int(sizeof(buf)))
+    {
+        out.assign(buf, len);
         return;
+    }
 
-    if (m_colored)
-        SetColor(true,WHITE);
+    // long line, _vsnprintf not return required size so grow until fit
+    std::vector<char> big(len >= 0 ? len + 1 : sizeof(buf) * 2);
+    for (;;)
+    {
+        va_copy(ap2, ap);
+        len = vsnprintf(&big[0], big.size(), str, ap2);
+        va_end(ap2);
 
-    // not expected utf8 and then send as-is
-    printf("%s", str);
+        if (len >= 0 && len < int(big.size()))
+            break;
 
-    if (m_colored)
-        ResetColor(true);
+        big.resize(len >= 0 ? len + 1 : big.size() * 2);
+    }
 
-    printf("\n");
-    if (logfile)
+    out.assign(&big[0], len);
+}
+
+static void consolePrintf(FILE* out, const char* str, ...)
+{
+    va_list ap;
+    va_start(ap, str);
+    vutf8printf(out, str, &ap);
+    va_end(ap);
+}
+
+void Log::WriteRecord(LogRecord const& rec, std::string const& text)
+{
+    if (rec.flags & LOG_RECORD_CONSOLE)
     {
-        fprintf(logfile, "%s", str);
-        fprintf(logfile, "\n" );
-        fflush(logfile);
+        bool stdout_stream = !(rec.flags & LOG_RECORD_STDERR);
+        FILE* out = stdout_stream ? stdout : stderr;
+
+        if (rec.color >= 0)
+            SetColor(stdout_stream, Color(rec.color));
+
+        if (rec.flags & LOG_RECORD_TIME)
+        {
+            tm* aTm = localtime(&rec.time);
+            fprintf(out, "%02d:%02d:%02d ",aTm->tm_hour,aTm->tm_min,aTm->tm_sec);
+        }
+
+        consolePrintf(out, "%s", text.c_str());
+
+        if (rec.color >= 0)
+            ResetColor(stdout_stream);
+
+        if (rec.flags & LOG_RECORD_NEWLINE)
+            fputc('\n', out);
     }
+    else
+    {
+        if (rec.flags & LOG_RECORD_TIME)
+        {
+            tm* aTm = localtime(&rec.time);
+            fprintf(rec.file,"%-4d-%02d-%02d %02d:%02d:%02d ",aTm->tm_year+1900,aTm->tm_mon+1,aTm->tm_mday,aTm->tm_hour,aTm->tm_min,aTm->tm_sec);
+        }
 
-    fflush(stdout);
+        fwrite(text.data(), 1, text.size(), rec.file);
+
+        if (rec.flags & LOG_RECORD_NEWLINE)
+            fputc('\n', rec.file);
+    }
 }
 
-void Log::outString()
+// text is copied into record only when it is queued, synchronous output writes it from caller
+void Log::outRecord(LogRecord& rec, std::string const& text)
 {
-    if (m_includeTime)
-        outTime();
-    printf( "\n" );
-    if (logfile)
+    if (m_writerBody && m_asyncOutput)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n" );
-        fflush(logfile);
+        if (&text != &rec.text)
+            rec.text = text;
+
+        if (m_writerBody->Queue(rec))
+            return;
     }
 
-    fflush(stdout);
+    WriteRecord(rec, text);
+
+    if (rec.flags & LOG_RECORD_CONSOLE)
+        fflush((rec.flags & LOG_RECORD_STDERR) ? stderr : stdout);
+    else
+        fflush(rec.file);
 }
 
-void Log::outString( const char * str, ... )
+void Log::outConsole(bool stdout_stream, int8 color, bool withTime, bool newline, std::string const& text)
+{
+    LogRecord rec;
+    rec.time = time(NULL);
+    rec.flags = LOG_RECORD_CONSOLE;
+    if (!stdout_stream)
+        rec.flags |= LOG_RECORD_STDERR;
+    if (withTime)
+        rec.flags |= LOG_RECORD_TIME;
+    if (newline)
+        rec.flags |= LOG_RECORD_NEWLINE;
+    rec.color = m_colored ? color : -1;
+
+    outRecord(rec, text);
+}
+
+void Log::outFile(FILE* file, bool timestamp, bool newline, std::string const& text)
+{
+    LogRecord rec;
+    rec.time = time(NULL);
+    rec.file = file;
+    if (timestamp)
+        rec.flags |= LOG_RECORD_TIME;
+    if (newline)
+        rec.flags |= LOG_RECORD_NEWLINE;
+
+    outRecord(rec, text);
+}
+
+void Log::outTitle( const char * str)
 {
     if (!str)
         return;
 
-    if (m_colored)
-        SetColor(true,m_colors[LogNormal]);
-
-    if (m_includeTime)
-        outTime();
+    // not expected utf8 and then send as-is
+    std::string text = str;
 
-    va_list ap;
+    outConsole(true, WHITE, false, true, text);
 
-    va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
-    va_end(ap);
+    if (logfile)
+        outFile(logfile, false, true, text);
+}
 
-    if (m_colored)
-        ResetColor(true);
+void Log::outString()
+{
+    std::string text;
 
-    printf( "\n" );
+    outConsole(true, -1, m_includeTime, true, text);
 
     if (logfile)
-    {
-        outTimestamp(logfile);
+        outFile(logfile, true, true, text);
+}
+
+void Log::outString( const char * str, ... )
+{
+    if (!str)
+        return;
 
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
-        va_end(ap);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        fflush(logfile);
-    }
+    outConsole(true, m_colors[LogNormal], m_includeTime, true, text);
 
-    fflush(stdout);
+    if (logfile)
+        outFile(logfile, true, true, text);
 }
 
 void Log::outError( const char * err, ... )
@@ -427,36 +579,16 @@ void Log::outError( const char * err, ... )
     if (!err)
         return;
 
-    if (m_colored)
-        SetColor(false,m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
+    std::string text;
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    vformat(text, err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
+    outConsole(false, m_colors[LogError], m_includeTime, true, text);
 
-    fprintf( stderr, "\n" );
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:" );
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
-
-    fflush(stderr);
+        outFile(logfile, true, true, "ERROR:" + text);
 }
 
 void Log::outErrorDb( const char * err, ... )
@@ -464,197 +596,92 @@ void Log::outErrorDb( const char * err, ... )
     if (!err)
         return;
 
-    if (m_colored)
-        SetColor(false,m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
+    std::string text;
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    vformat(text, err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf( stderr, "\n" );
+    outConsole(false, m_colors[LogError], m_includeTime, true, text);
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:" );
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
+        outFile(logfile, true, true, "ERROR:" + text);
 
     if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
-
-        fprintf(dberLogfile, "\n" );
-        fflush(dberLogfile);
-    }
-
-    fflush(stderr);
+        outFile(dberLogfile, true, true, text);
 }
 
 void Log::outBasic( const char * str, ... )
 {
-    if (!str)
+    // not format anything for disabled level
+    if (!str || !HasLogLevelOrHigher(LOG_LVL_BASIC))
         return;
 
-    if (m_logLevel >= LOG_LVL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true,m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        printf( "\n" );
-    }
+    if (m_logLevel >= LOG_LVL_BASIC)
+        outConsole(true, m_colors[LogDetails], m_includeTime, true, text);
 
     if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
-    {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
-        va_end(ap);
-        fflush(logfile);
-    }
-
-    fflush(stdout);
+        outFile(logfile, true, true, text);
 }
 
 void Log::outDetail( const char * str, ... )
 {
-    if (!str)
+    if (!str || !HasLogLevelOrHigher(LOG_LVL_DETAIL))
         return;
 
-    if (m_logLevel >= LOG_LVL_DETAIL)
-    {
-
-        if (m_colored)
-            SetColor(true,m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        printf( "\n" );
-    }
+    if (m_logLevel >= LOG_LVL_DETAIL)
+        outConsole(true, m_colors[LogDetails], m_includeTime, true, text);
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
-    {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
-
-    fflush(stdout);
+        outFile(logfile, true, true, text);
 }
 
 void Log::outDebugInLine( const char * str, ... )
 {
-    if (!str)
+    if (!str || !HasLogLevelOrHigher(LOG_LVL_DEBUG))
         return;
 
-    if (m_logLevel >= LOG_LVL_DEBUG)
-    {
-        if (m_colored)
-            SetColor(true,m_colors[LogDebug]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        if (m_colored)
-            ResetColor(true);
-    }
+    if (m_logLevel >= LOG_LVL_DEBUG)
+        outConsole(true, m_colors[LogDebug], false, false, text);
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
-    {
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-    }
+        outFile(logfile, false, false, text);
 }
 
 void Log::outDebug( const char * str, ... )
 {
-    if (!str)
+    if (!str || !HasLogLevelOrHigher(LOG_LVL_DEBUG))
         return;
 
-    if (m_logLevel >= LOG_LVL_DEBUG)
-    {
-        if (m_colored)
-            SetColor(true,m_colors[LogDebug]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        printf( "\n" );
-    }
+    if (m_logLevel >= LOG_LVL_DEBUG)
+        outConsole(true, m_colors[LogDebug], m_includeTime, true, text);
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
-    {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
-
-    fflush(stdout);
+        outFile(logfile, true, true, text);
 }
 
 void Log::outCommand( uint32 account, const char * str, ... )
@@ -662,79 +689,44 @@ void Log::outCommand( uint32 account, const char * str, ... )
     if (!str)
         return;
 
-    if (m_logLevel >= LOG_LVL_DETAIL)
-    {
-        if (m_colored)
-            SetColor(true,m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-        printf( "\n" );
-    }
+    if (m_logLevel >= LOG_LVL_DETAIL)
+        outConsole(true, m_colors[LogDetails], m_includeTime, true, text);
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
-    {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n" );
-        va_end(ap);
-        fflush(logfile);
-    }
+        outFile(logfile, true, true, text);
 
     if (m_gmlog_per_account)
     {
+        // file is opened for this line only, write it in place
         if (FILE* per_file = openGmlogPerAccount (account))
         {
-            va_list ap;
             outTimestamp(per_file);
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n" );
-            va_end(ap);
+            fprintf(per_file, "%s\n", text.c_str());
             fclose(per_file);
         }
     }
     else if (gmLogfile)
-    {
-        va_list ap;
-        outTimestamp(gmLogfile);
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n" );
-        va_end(ap);
-        fflush(gmLogfile);
-    }
-
-    fflush(stdout);
+        outFile(gmLogfile, true, true, text);
 }
 
 void Log::outChar(const char * str, ... )
 {
-
-    if (!str)
+    if (!str || !charLogfile)
         return;
 
-    if (charLogfile)
-    {
-        va_list ap;
-        outTimestamp(charLogfile);
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n" );
-        va_end(ap);
-        fflush(charLogfile);
-    }
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
+
+    outFile(charLogfile, true, true, text);
 }
 
 void Log::outWorldPacketDump( uint32 socket, uint32 opcode, char const* opcodeName, ByteBuffer const* packet, bool incoming )
@@ -742,32 +734,58 @@ void Log::outWorldPacketDump( uint32 socket, uint32 opcode, char const* opcodeNa
     if (!worldLogfile)
         return;
 
-    outTimestamp(worldLogfile);
+    LogRecord rec;
+    rec.file = worldLogfile;
+    rec.flags = LOG_RECORD_RAW;
+
+    // name is written before first packet of opcode from each thread: records of one thread
+    // keep their order, other threads may write same name again, converter just replaces it
+    PacketCaptureNames* names = *m_packetCaptureNames;
+    if (opcode < PACKET_CAPTURE_MAX_OPCODE && opcode >= names->named.size())
+        names->named.resize(opcode + 1, 0);
 
-    fprintf(worldLogfile,"\n%s:\nSOCKET: %u\nLENGTH: " SIZEFMTD "\nOPCODE: %s (0x%.4X)\nDATA:\n",
-        incoming ? "CLIENT" : "SERVER",
-        socket, packet->size(), opcodeName, opcode);
+    bool writeName = opcode < PACKET_CAPTURE_MAX_OPCODE && !names->named[opcode];
+    size_t nameLen = writeName ? std::min(strlen(opcodeName), size_t(255)) : 0;
 
-    size_t p = 0;
-    while (p < packet->size())
+    rec.text.reserve((writeName ? 1 + 2 + 1 + nameLen : 0) + PACKET_CAPTURE_PACKET_HEADER + packet->size());
+
+    if (writeName)
     {
-        for (size_t j = 0; j < 16 && p < packet->size(); ++j)
-            fprintf(worldLogfile, "%.2X ", (*packet)[p++]);
+        names->named[opcode] = 1;
 
-        fprintf(worldLogfile, "\n");
+        appendLE(rec.text, uint8(PACKET_CAPTURE_OPCODE));
+        appendLE(rec.text, uint16(opcode));
+        appendLE(rec.text, uint8(nameLen));
+        rec.text.append(opcodeName, nameLen);
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    ACE_Time_Value now = ACE_OS::gettimeofday();
+
+    appendLE(rec.text, uint8(PACKET_CAPTURE_PACKET));
+    appendLE(rec.text, uint64(now.sec()) * 1000 + uint64(now.usec() / 1000));
+    appendLE(rec.text, uint8(incoming ? PACKET_CAPTURE_CLIENT : PACKET_CAPTURE_SERVER));
+    appendLE(rec.text, uint32(socket));
+    appendLE(rec.text, uint16(opcode));
+    appendLE(rec.text, uint32(packet->size()));
+    if (packet->size())
+        rec.text.append((char const*)packet->contents(), packet->size());
+
+    outRecord(rec, rec.text);
 }
 
 void Log::outCharDump( const char * str, uint32 account_id, uint32 guid, const char * name )
 {
-    if (charLogfile)
-    {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n",account_id,guid,name,str );
-        fflush(charLogfile);
-    }
+    if (!charLogfile)
+        return;
+
+    char header[256];
+    snprintf(header, 256, "== START DUMP == (account: %u guid: %u name: %s )\n", account_id, guid, name);
+
+    std::string text = header;
+    text += str;
+    text += "\n== END DUMP ==";
+
+    outFile(charLogfile, false, true, text);
 }
 
 void Log::outMenu( const char * str, ... )
@@ -775,50 +793,30 @@ void Log::outMenu( const char * str, ... )
     if (!str)
         return;
 
-    SetColor(true,m_colors[LogNormal]);
-
-    if (m_includeTime)
-        outTime();
-
+    std::string text;
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    vformat(text, str, ap);
     va_end(ap);
 
-    ResetColor(true);
+    outConsole(true, m_colors[LogNormal], m_includeTime, false, text);
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
-    fflush(stdout);
+        outFile(logfile, true, true, text);
 }
 
 void Log::outRALog(    const char * str, ... )
 {
-    if (!str)
+    if (!str || !raLogfile)
         return;
 
-    if (raLogfile)
-    {
-        va_list ap;
-        outTimestamp(raLogfile);
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n" );
-        va_end(ap);
-        fflush(raLogfile);
-    }
+    std::string text;
+    va_list ap;
+    va_start(ap, str);
+    vformat(text, str, ap);
+    va_end(ap);
 
-    fflush(stdout);
+    outFile(raLogfile, true, true, text);
 }
 
 void Log::WaitBeforeContinueIfNeed()
@@ -24,6 +24,15 @@
 
 class Config;
 class ByteBuffer;
+class LogWriter;
+struct LogRecord;
+struct PacketCaptureNames;
+template <class TYPE> class ACE_TSS;
+
+namespace ACE_Based
+{
+    class Thread;
+}
 
 enum LogLevel
 {
@@ -87,10 +96,13 @@ const int Color_count = int(WHITE)+1;
 class Log : public Diamond::Singleton<Log, Diamond::ClassLevelLockable<Log, ACE_Thread_Mutex> >
 {
     friend class Diamond::OperatorNew<Log>;
+    friend class LogWriter;
     Log();
 
     ~Log()
     {
+        HaltWriterThread();
+
         if( logfile != NULL )
             fclose(logfile);
         logfile = NULL;
@@ -159,9 +171,18 @@ class Log : public Diamond::Singleton<Log, Diamond::ClassLevelLockable<Log, ACE_
         bool IsIncludeTime() const { return m_includeTime; }
 
         static void WaitBeforeContinueIfNeed();
+
+        // stop background writer (if used) after writing all queued output
+        void HaltWriterThread();
     private:
         FILE* openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
+        void InitWriterThread(uint32 queueSize, uint32 flushInterval);
+
+        void outConsole(bool stdout_stream, int8 color, bool withTime, bool newline, std::string const& text);
+        void outFile(FILE* file, bool timestamp, bool newline, std::string const& text);
+        void outRecord(LogRecord& rec, std::string const& text);
+        void WriteRecord(LogRecord const& rec, std::string const& text);
 
         FILE* raLogfile;
         FILE* logfile;
@@ -188,6 +209,14 @@ class Log : public Diamond::Singleton<Log, Diamond::ClassLevelLockable<Log, ACE_
         // gm log control
         bool m_gmlog_per_account;
         std::string m_gmlog_filename_format;
+
+        // async output control
+        bool m_asyncOutput;
+        LogWriter* m_writerBody;
+        ACE_Based::Thread* m_writerThread;
+
+        // packet capture control
+        ACE_TSS<PacketCaptureNames>* m_packetCaptureNames;  // per thread (own ring in async mode), deleted by ACE at thread exit
 };
 
 #define sLog Diamond::Singleton<Log>::Instance()
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LogWriter.h"
+#include "Log.h"
+#include "Timer.h"
+#include <ace/Guard_T.h>
+#include <algorithm>
+
+#define LOG_WRITER_IDLE_SLEEP 10                            // ms between polls of empty rings
+
+LogRingBuffer::LogRingBuffer(uint32 size) : m_closed(false)
+{
+    // round up to power of 2 for cheap index wrap
+    uint32 slots = 2;
+    while (slots < size)
+        slots <<= 1;
+
+    m_slots.resize(slots, NULL);
+    m_mask = long(slots - 1);
+    m_head = 0;
+    m_tail = 0;
+}
+
+bool LogRingBuffer::Push(LogRecord* rec)
+{
+    long tail = m_tail.value();
+    if (tail - m_head.value() > m_mask)
+        return false;
+
+    m_slots[tail & m_mask] = rec;
+    m_tail = tail + 1;                                      // publish slot after it is filled
+    return true;
+}
+
+LogRecord* LogRingBuffer::Pop()
+{
+    long head = m_head.value();
+    if (head == m_tail.value())
+        return NULL;
+
+    LogRecord* rec = m_slots[head & m_mask];
+    m_head = head + 1;                                      // release slot after it is read
+    return rec;
+}
+
+static bool LogRecordOrder(LogRecord const* a, LogRecord const* b)
+{
+    // sequence can wrap, compare by distance
+    return int32(a->seq - b->seq) < 0;
+}
+
+LogWriter::LogWriter(uint32 queueSize, uint32 flushInterval) :
+    m_queueSize(queueSize), m_flushInterval(flushInterval)
+{
+    m_sequence = 0;
+    m_running = 1;
+    m_queueCalls = 0;
+}
+
+void LogWriter::Stop()
+{
+    m_running = 0;
+
+    // calls which have seen writer running finish their push, records pushed later would never be written
+    while (m_queueCalls.value())
+        ACE_Based::Thread::Sleep(1);
+}
+
+bool LogWriter::Queue(LogRecord& rec)
+{
+    // counted before running check, so Stop can't miss a call about to push
+    ++m_queueCalls;
+    bool queued = m_running.value() && QueueRecord(rec);
+    --m_queueCalls;
+    return queued;
+}
+
+bool LogWriter::QueueRecord(LogRecord& rec)
+{
+    // operator-> creates buffer at first use in thread
+    ThreadBuffer* buffer = m_threadBuffer.operator->();
+    if (!buffer)
+        return false;
+
+    if (!buffer->ring)
+    {
+        buffer->ring = new LogRingBuffer(m_queueSize);
+
+        ACE_Guard<ACE_Thread_Mutex> guard(m_ringsLock);
+        m_rings.push_back(buffer->ring);
+    }
+
+    LogRecord* queued = new LogRecord;
+    queued->seq = uint32(++m_sequence);
+    queued->time = rec.time;
+    queued->file = rec.file;
+    queued->flags = rec.flags;
+    queued->color = rec.color;
+    queued->text.swap(rec.text);
+
+    // ring full: writer is behind, wait for it instead of dropping lines
+    while (!buffer->ring->Push(queued))
+    {
+        if (!m_running.value())
+        {
+            rec.text.swap(queued->text);
+            delete queued;
+            return false;
+        }
+
+        ACE_Based::Thread::Sleep(1);
+    }
+
+    return true;
+}
+
+bool LogWriter::WriteBatch()
+{
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_ringsLock);
+
+        for (RingList::iterator itr = m_rings.begin(); itr != m_rings.end();)
+        {
+            // closed state must be checked before draining, so records pushed before Close() are not lost
+            bool closed = (*itr)->IsClosed();
+
+            while (LogRecord* rec = (*itr)->Pop())
+                m_batch.push_back(rec);
+
+            if (closed)
+            {
+                delete *itr;
+                itr = m_rings.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    if (m_batch.empty())
+        return false;
+
+    // rings are ordered per thread only, restore call order between threads
+    std::sort(m_batch.begin(), m_batch.end(), LogRecordOrder);
+
+    for (std::vector<LogRecord*>::const_iterator itr = m_batch.begin(); itr != m_batch.end(); ++itr)
+    {
+        LogRecord* rec = *itr;
+        sLog.WriteRecord(*rec, rec->text);
+
+        if (rec->flags & LOG_RECORD_CONSOLE)
+            m_dirty.insert((rec->flags & LOG_RECORD_STDERR) ? stderr : stdout);
+        else
+            m_dirty.insert(rec->file);
+
+        delete rec;
+    }
+
+    m_batch.clear();
+    return true;
+}
+
+void LogWriter::FlushTargets()
+{
+    for (std::set<FILE*>::const_iterator itr = m_dirty.begin(); itr != m_dirty.end(); ++itr)
+        fflush(*itr);
+
+    m_dirty.clear();
+}
+
+void LogWriter::Drain()
+{
+    while (WriteBatch())
+        ;
+
+    FlushTargets();
+}
+
+void LogWriter::run()
+{
+    uint32 lastFlush = getMSTime();
+
+    while (m_running.value())
+    {
+        bool written = WriteBatch();
+
+        // 0 interval: flush every batch, else flush at most once per interval
+        uint32 now = getMSTime();
+        if (!m_dirty.empty() && getMSTimeDiff(lastFlush, now) >= m_flushInterval)
+        {
+            FlushTargets();
+            lastFlush = now;
+        }
+
+        if (!written)
+            ACE_Based::Thread::Sleep(LOG_WRITER_IDLE_SLEEP);
+    }
+
+    // if the running state gets turned off while sleeping
+    // empty the rings before exiting
+    Drain();
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_LOGWRITER_H
+#define DIAMOND_LOGWRITER_H
+
+#include "Common.h"
+#include "Threading.h"
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <set>
+
+enum LogRecordFlags
+{
+    LOG_RECORD_CONSOLE  = 0x01,                             // console output (colored, utf8 converted)
+    LOG_RECORD_STDERR   = 0x02,                             // console record goes to stderr instead stdout
+    LOG_RECORD_TIME     = 0x04,                             // [hh:mm:ss] for console, full timestamp for files
+    LOG_RECORD_NEWLINE  = 0x08,                             // terminate line after text
+    LOG_RECORD_RAW      = 0x10                              // binary file data, written as-is in single fwrite
+};
+
+/// One already formatted line of log output
+struct LogRecord
+{
+    LogRecord() : seq(0), time(0), file(NULL), flags(0), color(-1) {}
+
+    uint32 seq;                                             ///< global order of records from different threads
+    time_t time;                                            ///< time of the log call, not of the write
+    FILE* file;                                             ///< target file, NULL for console records
+    uint8 flags;                                            ///< LogRecordFlags
+    int8 color;                                             ///< console color or -1 for default
+    std::string text;
+};
+
+/// Single producer / single consumer ring of records, one per logging thread
+class LogRingBuffer
+{
+    public:
+        explicit LogRingBuffer(uint32 size);
+
+        bool Push(LogRecord* rec);                          ///< owner thread only
+        LogRecord* Pop();                                   ///< writer thread only
+
+        void Close() { m_closed = true; }                   ///< owner thread exited, no more pushes
+        bool IsClosed() const { return m_closed; }
+
+    private:
+        std::vector<LogRecord*> m_slots;
+        long m_mask;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_head;       ///< next slot to read, advanced by writer
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_tail;       ///< next slot to write, advanced by owner
+        volatile bool m_closed;
+};
+
+/// Background thread writing queued log records with batched flushes
+class LogWriter : public ACE_Based::Runnable
+{
+    public:
+        LogWriter(uint32 queueSize, uint32 flushInterval);
+
+        ///< Move record to the calling thread ring, false if it must be written synchronously
+        bool Queue(LogRecord& rec);
+
+        void Stop();                                        ///< Stop event, later Queue calls fail
+        void Drain();                                       ///< Write all queued records, used after thread exit
+        virtual void run();                                 ///< Main Thread loop
+
+    private:
+        struct ThreadBuffer
+        {
+            ThreadBuffer() : ring(NULL) {}
+            ~ThreadBuffer() { if (ring) ring->Close(); }
+
+            LogRingBuffer* ring;
+        };
+
+        typedef std::vector<LogRingBuffer*> RingList;
+
+        bool QueueRecord(LogRecord& rec);
+        bool WriteBatch();
+        void FlushTargets();
+
+        ACE_TSS<ThreadBuffer> m_threadBuffer;
+        RingList m_rings;
+        ACE_Thread_Mutex m_ringsLock;                       ///< guards m_rings, taken once per new thread and per batch
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_sequence;
+
+        std::vector<LogRecord*> m_batch;
+        std::set<FILE*> m_dirty;                            ///< targets written since last flush
+
+        uint32 m_queueSize;
+        uint32 m_flushInterval;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_running;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_queueCalls; ///< Queue calls in progress, Stop waits for them
+};
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DIAMOND_PACKETCAPTURE_H
+#define DIAMOND_PACKETCAPTURE_H
+
+/*
+ * Binary world packet capture (WorldLogFile), shared with contrib/packet_dump.
+ * Header only with plain defines, so the converter tool can be built without ACE.
+ *
+ * File is a sequence of chunks, all values little endian, no padding.
+ * Every chunk start from uint8 chunk type:
+ *
+ * PACKET_CAPTURE_SESSION  - written at each file open (file opened in append mode)
+ *     char[4] magic "DCPK", uint16 version
+ * PACKET_CAPTURE_OPCODE   - name of opcode, written before its first packet in session
+ *     uint16 opcode, uint8 name length, char[length] name (not 0 terminated)
+ * PACKET_CAPTURE_PACKET   - one world packet
+ *     uint64 time (ms since epoch), uint8 direction, uint32 socket,
+ *     uint16 opcode, uint32 length, uint8[length] payload
+ */
+
+#define PACKET_CAPTURE_MAGIC            "DCPK"
+#define PACKET_CAPTURE_VERSION          1
+
+enum PacketCaptureChunk
+{
+    PACKET_CAPTURE_SESSION  = 0,
+    PACKET_CAPTURE_OPCODE   = 1,
+    PACKET_CAPTURE_PACKET   = 2
+};
+
+enum PacketCaptureDirection
+{
+    PACKET_CAPTURE_SERVER   = 0,                            // server to client
+    PACKET_CAPTURE_CLIENT   = 1                             // client to server
+};
+
+#define PACKET_CAPTURE_SESSION_SIZE     (1 + 4 + 2)
+#define PACKET_CAPTURE_PACKET_HEADER    (1 + 8 + 1 + 4 + 2 + 4)
+#define PACKET_CAPTURE_MAX_OPCODE       0x10000
+
+#endif
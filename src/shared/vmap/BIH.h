@@ -25,6 +25,8 @@
 
 #include <Platform/Define.h>
 
+#include "MappedArray.h"
+
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
@@ -32,6 +34,7 @@
 #include <cmath>
 
 #define MAX_STACK_SIZE 64
+#define RAY_PACKET_SIZE 8
 
 #ifdef _MSC_VER
 	#define isnan(x) _isnan(x)
@@ -103,18 +106,28 @@ class BIH
             if (printStats)
                 stats.printStats();
 
-            objects.resize(dat.numPrims);
-            for (uint32 i=0; i<dat.numPrims; ++i)
-                objects[i] = dat.indices[i];
+            std::vector<uint32> tempObjects(dat.indices, dat.indices + dat.numPrims);
+            objects.swap(tempObjects);
             //nObjects = dat.numPrims;
-            tree = tempTree;
+            tree.swap(tempTree);
             delete[] dat.primBound;
             delete[] dat.indices;
         }
         uint32 primCount() { return objects.size(); }
+        //! primitive index stored at position pos of leaf order, leaves reference continuous position ranges
+        uint32 getObject(uint32 pos) const { return objects[pos]; }
 
         template<typename RayCallback>
         void intersectRay(const Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
+        {
+            ObjectRayCallback<RayCallback> leafCallback(objects, intersectCallback);
+            intersectRayLeaves(r, leafCallback, maxDist, stopAtFirst);
+        }
+
+        /*! same as intersectRay, but callback gets whole leaf as range of positions in leaf order:
+            bool operator()(const Ray &r, uint32 firstPos, uint32 count, float &maxDist, bool stopAtFirst) */
+        template<typename LeafCallback>
+        void intersectRayLeaves(const Ray &r, LeafCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
         {
             float intervalMin = 0.f;
             float intervalMax = maxDist;
@@ -208,11 +221,9 @@ class BIH
                         {
                             // leaf - test some objects
                             int n = tree[node + 1];
-                            while (n > 0) {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
+                            if (n > 0) {
+                                bool hit = intersectCallback(r, offset, n, maxDist, stopAtFirst);
                                 if(stopAtFirst && hit) return;
-                                --n;
-                                ++offset;
                             }
                             break;
                         }
@@ -248,6 +259,163 @@ class BIH
             }
         }
 
+        /*! traverses tree once for up to RAY_PACKET_SIZE rays, a ray leaves the packet at its first hit.
+            Children are visited while any ray of packet passes them, so near/far order is not kept
+            and it is only usable for "any hit" queries like line of sight. */
+        template<typename RayCallback>
+        void intersectRayPacket(const Ray *rays, float *maxDist, uint32 count, RayCallback& intersectCallback) const
+        {
+            PacketStackNode cur;
+            cur.node = 0;
+            cur.mask = 0;
+
+            Vector3 org[RAY_PACKET_SIZE];
+            Vector3 invDir[RAY_PACKET_SIZE];
+            uint32 negDir[RAY_PACKET_SIZE][3];
+            for (uint32 r = 0; r < count; ++r)
+            {
+                org[r] = rays[r].origin();
+                float intervalMin = 0.f;
+                float intervalMax = maxDist[r];
+                for (int i=0; i<3; ++i)
+                {
+                    negDir[r][i] = floatToRawIntBits(rays[r].direction()[i]) >> 31;
+                    invDir[r][i] = 1.f / rays[r].direction()[i];
+                    float t1 = (bounds.low()[i] - org[r][i]) * invDir[r][i];
+                    float t2 = (bounds.high()[i] - org[r][i]) * invDir[r][i];
+                    if (invDir[r][i] > 0) {
+                        if (t1 > intervalMin)
+                            intervalMin = t1;
+                        if (t2 < intervalMax)
+                            intervalMax = t2;
+                    } else {
+                        if (t2 > intervalMin)
+                            intervalMin = t2;
+                        if (t1 < intervalMax)
+                            intervalMax = t1;
+                    }
+                }
+                if (intervalMin > intervalMax)
+                    continue;
+                cur.mask |= 1 << r;
+                cur.tnear[r] = intervalMin;
+                cur.tfar[r] = intervalMax;
+            }
+
+            uint32 active = cur.mask;                       // rays without hit yet
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+
+            while (true) {
+                while (cur.mask)
+                {
+                    uint32 tn = tree[cur.node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = tn & (1 << 29);
+                    int offset = tn & ~(7 << 29);
+                    float tl = intBitsToFloat(tree[cur.node + 1]);
+                    float tr = intBitsToFloat(tree[cur.node + 2]);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, split rays to left and right child
+                            PacketStackNode right;
+                            right.node = offset + 3;
+                            right.mask = 0;
+                            uint32 leftMask = 0;
+                            for (uint32 r = 0; r < count; ++r)
+                            {
+                                if (!(cur.mask & (1 << r)))
+                                    continue;
+                                float tL = (tl - org[r][axis]) * invDir[r][axis];
+                                float tR = (tr - org[r][axis]) * invDir[r][axis];
+                                float lMin = cur.tnear[r], lMax = cur.tfar[r];
+                                float rMin = cur.tnear[r], rMax = cur.tfar[r];
+                                if (negDir[r][axis]) {
+                                    lMin = (tL >= lMin) ? tL : lMin;
+                                    rMax = (tR <= rMax) ? tR : rMax;
+                                } else {
+                                    lMax = (tL <= lMax) ? tL : lMax;
+                                    rMin = (tR >= rMin) ? tR : rMin;
+                                }
+                                if (lMin <= lMax) {
+                                    leftMask |= 1 << r;
+                                    cur.tnear[r] = lMin;
+                                    cur.tfar[r] = lMax;
+                                }
+                                if (rMin <= rMax) {
+                                    right.mask |= 1 << r;
+                                    right.tnear[r] = rMin;
+                                    right.tfar[r] = rMax;
+                                }
+                            }
+                            cur.node = offset;
+                            cur.mask = leftMask;
+                            if (!right.mask)
+                                continue;
+                            if (!cur.mask)
+                                cur = right;
+                            else
+                                stack[stackPos++] = right;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[cur.node + 1];
+                            for (; n > 0 && cur.mask; --n, ++offset)
+                            {
+                                for (uint32 r = 0; r < count; ++r)
+                                {
+                                    if (!(cur.mask & (1 << r)))
+                                        continue;
+                                    if (intersectCallback(rays[r], objects[offset], maxDist[r], true))
+                                    {
+                                        active &= ~(1 << r);
+                                        cur.mask &= ~(1 << r);
+                                    }
+                                }
+                            }
+                            if (!active)
+                                return;
+                            break;
+                        }
+                    }
+                    else // BVH2 node (empty space cut off left and right)
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        uint32 mask = 0;
+                        for (uint32 r = 0; r < count; ++r)
+                        {
+                            if (!(cur.mask & (1 << r)))
+                                continue;
+                            float tf = (intBitsToFloat(tree[cur.node + 1 + negDir[r][axis]]) - org[r][axis]) * invDir[r][axis];
+                            float tb = (intBitsToFloat(tree[cur.node + 2 - negDir[r][axis]]) - org[r][axis]) * invDir[r][axis];
+                            cur.tnear[r] = (tf >= cur.tnear[r]) ? tf : cur.tnear[r];
+                            cur.tfar[r] = (tb <= cur.tfar[r]) ? tb : cur.tfar[r];
+                            if (cur.tnear[r] <= cur.tfar[r])
+                                mask |= 1 << r;
+                        }
+                        cur.node = offset;
+                        cur.mask = mask;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, drop rays which already hit
+                    stackPos--;
+                    cur = stack[stackPos];
+                    cur.mask &= active;
+                } while (!cur.mask);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -328,10 +496,30 @@ class BIH
 
         bool writeToFile(FILE *wf) const;
         bool readFromFile(FILE *rf);
+        bool readFromMemory(VMAP::MemoryReader &reader);
 
     protected:
-        std::vector<uint32> tree;
-        std::vector<uint32> objects;
+        //! calls per object callback for every object of a leaf
+        template<typename RayCallback>
+        struct ObjectRayCallback
+        {
+            ObjectRayCallback(const VMAP::MappedArray<uint32> &obj, RayCallback &cb): objects(obj), callback(cb) {}
+            bool operator()(const Ray &r, uint32 offset, uint32 n, float &maxDist, bool stopAtFirst)
+            {
+                for (; n > 0; --n, ++offset)
+                {
+                    bool hit = callback(r, objects[offset], maxDist, stopAtFirst);
+                    if (stopAtFirst && hit)
+                        return true;
+                }
+                return false;
+            }
+            const VMAP::MappedArray<uint32> &objects;
+            RayCallback &callback;
+        };
+
+        VMAP::MappedArray<uint32> tree;
+        VMAP::MappedArray<uint32> objects;
         AABox bounds;
 
         struct buildData
@@ -341,6 +529,13 @@ class BIH
             uint32 numPrims;
             int maxPrims;
         };
+        struct PacketStackNode
+        {
+            uint32 node;
+            uint32 mask;                                    // rays passing node
+            float tnear[RAY_PACKET_SIZE];
+            float tfar[RAY_PACKET_SIZE];
+        };
         struct StackNode
         {
             uint32 node;
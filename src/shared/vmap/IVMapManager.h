@@ -38,6 +38,14 @@ namespace VMAP
         VMAP_LOAD_RESULT_IGNORED,
     };
 
+    /// one ray of batched line of sight check, result is filled by check
+    struct LineOfSightQuery
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+        bool result;
+    };
+
     #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
     #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
@@ -47,13 +55,19 @@ namespace VMAP
         private:
             bool iEnableLineOfSightCalc;
             bool iEnableHeightCalc;
+            bool iEnableModelFileMapping;
 
         public:
-            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true) {}
+            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true), iEnableModelFileMapping(false) {}
 
             virtual ~IVMapManager(void) {}
 
             virtual int loadMap(const char* pBasePath, unsigned int pMapId, int x, int y) = 0;
+            /**
+            read files of tile without loading it, so later loadMap reads them from OS file cache
+            can be called from any thread
+            */
+            virtual void preloadMapFiles(const char* pBasePath, unsigned int pMapId, int x, int y) = 0;
 
             virtual bool existsMap(const char* pBasePath, unsigned int pMapId, int x, int y) = 0;
 
@@ -61,6 +75,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            check line of sight for many rays of same map at once, close rays (like from one caster
+            to targets around) traverse the map tree together
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, LineOfSightQuery* pQueries, unsigned int pCount) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z) = 0;
             /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
@@ -82,9 +101,16 @@ namespace VMAP
             It is enabled by default. If it is enabled in mid game the maps have to loaded manualy
             */
             void setEnableHeightCalc(bool pVal) { iEnableHeightCalc = pVal; }
+            /**
+            Enable/disable memory mapping of model files
+            Mesh data of mapped models is used in place and shared with OS file cache instead of copied to process memory.
+            Only models loaded after the change are affected
+            */
+            void setEnableModelFileMapping(bool pVal) { iEnableModelFileMapping = pVal; }
 
             bool isLineOfSightCalcEnabled() const { return(iEnableLineOfSightCalc); }
             bool isHeightCalcEnabled() const { return(iEnableHeightCalc); }
+            bool isModelFileMappingEnabled() const { return(iEnableModelFileMapping); }
             bool isMapLoadingEnabled() const { return(iEnableLineOfSightCalc || iEnableHeightCalc  ); }
 
             virtual std::string getDirFileName(unsigned int pMapId, int x, int y) const =0;
@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <set>
 
 using G3D::Vector3;
 
@@ -158,6 +159,49 @@ namespace VMAP
         }
         return result;
     }
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, uint32 count, std::vector<bool> &results) const
+    {
+        results.assign(count, true);
+
+        G3D::Ray rays[RAY_PACKET_SIZE];
+        float maxDist[RAY_PACKET_SIZE];
+        float length[RAY_PACKET_SIZE];
+        uint32 index[RAY_PACKET_SIZE];
+        uint32 packetSize = 0;
+        MapRayCallback intersectionCallBack(iTreeValues);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist < 1e-10f)
+                continue;
+
+            rays[packetSize] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/dist);
+            maxDist[packetSize] = dist;
+            length[packetSize] = dist;
+            index[packetSize] = i;
+            ++packetSize;
+
+            if (packetSize == RAY_PACKET_SIZE)
+            {
+                iTree.intersectRayPacket(rays, maxDist, packetSize, intersectionCallBack);
+                for (uint32 r = 0; r < packetSize; ++r)
+                    if (maxDist[r] < length[r])
+                        results[index[r]] = false;
+                packetSize = 0;
+            }
+        }
+
+        if (packetSize)
+        {
+            iTree.intersectRayPacket(rays, maxDist, packetSize, intersectionCallBack);
+            for (uint32 r = 0; r < packetSize; ++r)
+                if (maxDist[r] < length[r])
+                    results[index[r]] = false;
+        }
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -324,6 +368,45 @@ namespace VMAP
         iLoadedTiles.clear();
     }
 
+    //=========================================================
+    // read tile file and model files used by it without creating anything (thread safe),
+    // so LoadMapTile called later finds them in OS file cache; basePath must end with '/'
+
+    void StaticMapTree::PreloadMapTileFiles(const std::string &basePath, uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        std::string tilefile = basePath + getTileFileName(mapID, tileX, tileY);
+        FILE* tf = fopen(tilefile.c_str(), "rb");
+        if (!tf)
+            return;
+
+        std::set<std::string> models;
+        char buffer[16384];
+
+        uint32 numSpawns;
+        if (fread(&numSpawns, sizeof(uint32), 1, tf) == 1)
+        {
+            for (uint32 i=0; i<numSpawns; ++i)
+            {
+                ModelSpawn spawn;
+                uint32 referencedVal;
+                if (!ModelSpawn::readFromFile(tf, spawn) || fread(&referencedVal, sizeof(uint32), 1, tf) != 1)
+                    break;
+
+                // same model is used by many spawns
+                if (!models.insert(spawn.name).second)
+                    continue;
+
+                if (FILE* mf = fopen((basePath + spawn.name + ".vmo").c_str(), "rb"))
+                {
+                    while (fread(buffer, 1, sizeof(buffer), mf) == sizeof(buffer))
+                        ;
+                    fclose(mf);
+                }
+            }
+        }
+        fclose(tf);
+    }
+
     //=========================================================
 
     bool StaticMapTree::LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2 *vm)
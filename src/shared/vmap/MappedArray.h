@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MAPPEDARRAY_H
+#define _MAPPEDARRAY_H
+
+#include "Platform/Define.h"
+
+#include <vector>
+#include <cstring>
+
+namespace VMAP
+{
+    /** read only array of model data, either owning its elements or referencing
+        memory of a mapped model file. The mapping is owned and kept alive by WorldModel. */
+    template<class T>
+    class MappedArray
+    {
+        public:
+            typedef const T* const_iterator;
+
+            MappedArray(): iData(0), iSize(0) {}
+            MappedArray(const MappedArray &other): iData(0), iSize(0) { *this = other; }
+            MappedArray& operator=(const MappedArray &other)
+            {
+                if (this == &other)
+                    return *this;
+                iStorage = other.iStorage;
+                iSize = other.iSize;
+                iData = other.isReference() ? other.iData : (iStorage.empty() ? 0 : &iStorage[0]);
+                return *this;
+            }
+
+            //! take elements of vector, passed vector gets old owned elements
+            void swap(std::vector<T> &values)
+            {
+                iStorage.swap(values);
+                iSize = iStorage.size();
+                iData = iStorage.empty() ? 0 : &iStorage[0];
+            }
+            //! use elements in place, memory must outlive array
+            void reference(const T *data, uint32 size)
+            {
+                std::vector<T>().swap(iStorage);
+                iData = size ? data : 0;
+                iSize = size;
+            }
+            void clear() { std::vector<T>().swap(iStorage); iData = 0; iSize = 0; }
+
+            bool isReference() const { return iData && iStorage.empty(); }
+            uint32 size() const { return iSize; }
+            bool empty() const { return iSize == 0; }
+            const T& operator[](uint32 i) const { return iData[i]; }
+            const_iterator begin() const { return iData; }
+            const_iterator end() const { return iData + iSize; }
+        private:
+            std::vector<T> iStorage;
+            const T *iData;
+            uint32 iSize;
+    };
+
+    //! sequential reader of model file data in memory
+    class MemoryReader
+    {
+        public:
+            //! with referenceArrays, aligned arrays are referenced in place instead of copied
+            MemoryReader(const char *data, uint32 size, bool referenceArrays):
+                iPos(data), iEnd(data + size), iReferenceArrays(referenceArrays) {}
+
+            bool read(void *dest, uint32 size)
+            {
+                if (size > uint32(iEnd - iPos))
+                    return false;
+                memcpy(dest, iPos, size);
+                iPos += size;
+                return true;
+            }
+            bool skip(uint32 size)
+            {
+                if (size > uint32(iEnd - iPos))
+                    return false;
+                iPos += size;
+                return true;
+            }
+            bool readChunk(const char *compare, uint32 len)
+            {
+                if (len > uint32(iEnd - iPos) || memcmp(iPos, compare, len) != 0)
+                    return false;
+                iPos += len;
+                return true;
+            }
+            template<class T>
+            bool readArray(MappedArray<T> &out, uint32 count)
+            {
+                if (count > uint32(iEnd - iPos) / sizeof(T))
+                    return false;
+                // files of older assembler may have arrays after unaligned liquid data
+                if (iReferenceArrays && (size_t(iPos) % sizeof(uint32)) == 0)
+                    out.reference(reinterpret_cast<const T*>(iPos), count);
+                else
+                {
+                    std::vector<T> values(count);
+                    if (count)
+                        memcpy(static_cast<void*>(&values[0]), iPos, count * sizeof(T));
+                    out.swap(values);
+                }
+                iPos += count * sizeof(T);
+                return true;
+            }
+        private:
+            const char *iPos;
+            const char *iEnd;
+            bool iReferenceArrays;
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2010 DiamondCore <http://easy-emu.de/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MAPPEDFILE_H
+#define _MAPPEDFILE_H
+
+#include "Platform/Define.h"
+
+#include <string>
+
+#if PLATFORM == PLATFORM_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace VMAP
+{
+    //! whole file mapped read only, pages are shared with OS file cache
+    class MappedFile
+    {
+        public:
+            MappedFile(): iData(0), iSize(0)
+            {
+#if PLATFORM == PLATFORM_WINDOWS
+                iFile = INVALID_HANDLE_VALUE;
+                iMapping = NULL;
+#endif
+            }
+            ~MappedFile() { close(); }
+
+            bool open(const std::string &filename)
+            {
+                close();
+#if PLATFORM == PLATFORM_WINDOWS
+                iFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (iFile == INVALID_HANDLE_VALUE)
+                    return false;
+                iSize = GetFileSize(iFile, NULL);
+                if (iSize != INVALID_FILE_SIZE && iSize > 0)
+                    iMapping = CreateFileMappingA(iFile, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (iMapping)
+                    iData = static_cast<const char*>(MapViewOfFile(iMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+                int fd = ::open(filename.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return false;
+                struct stat st;
+                if (fstat(fd, &st) == 0 && st.st_size > 0)
+                {
+                    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                    if (data != MAP_FAILED)
+                    {
+                        iData = static_cast<const char*>(data);
+                        iSize = st.st_size;
+                    }
+                }
+                // mapping stays valid after closing descriptor
+                ::close(fd);
+#endif
+                if (!iData)
+                {
+                    close();
+                    return false;
+                }
+                return true;
+            }
+
+            void close()
+            {
+#if PLATFORM == PLATFORM_WINDOWS
+                if (iData)
+                    UnmapViewOfFile(iData);
+                if (iMapping)
+                    CloseHandle(iMapping);
+                if (iFile != INVALID_HANDLE_VALUE)
+                    CloseHandle(iFile);
+                iFile = INVALID_HANDLE_VALUE;
+                iMapping = NULL;
+#else
+                if (iData)
+                    munmap(const_cast<char*>(iData), iSize);
+#endif
+                iData = 0;
+                iSize = 0;
+            }
+
+            const char* data() const { return iData; }
+            uint32 size() const { return iSize; }
+        private:
+            MappedFile(const MappedFile &);
+            MappedFile& operator=(const MappedFile &);
+
+            const char *iData;
+            uint32 iSize;
+#if PLATFORM == PLATFORM_WINDOWS
+            HANDLE iFile;
+            HANDLE iMapping;
+#endif
+    };
+}
+
+#endif
@@ -27,6 +27,12 @@
 #include <sstream>
 #include <iomanip>
 
+#if PLATFORM == PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
@@ -45,6 +51,117 @@ namespace VMAP
         return memcmp(dest, compare, len) == 0;
     }
 
+    /**
+    Runs a TileAssembler job for every index in [0, count) on a number of threads.
+    Jobs are handed out in index order and stop being handed out after the first failure.
+    The vmap code is also built into standalone tools, so native threads are used instead of ACE.
+    */
+    class AssemblerJobQueue
+    {
+        public:
+            typedef bool (TileAssembler::*JobMethod)(uint32 index);
+
+            AssemblerJobQueue(TileAssembler* assembler, JobMethod job, uint32 count) :
+                iAssembler(assembler), iJob(job), iNext(0), iCount(count), iFailed(false)
+            {
+#if PLATFORM == PLATFORM_WINDOWS
+                InitializeCriticalSection(&iLock);
+#else
+                pthread_mutex_init(&iLock, NULL);
+#endif
+            }
+
+            ~AssemblerJobQueue()
+            {
+#if PLATFORM == PLATFORM_WINDOWS
+                DeleteCriticalSection(&iLock);
+#else
+                pthread_mutex_destroy(&iLock);
+#endif
+            }
+
+            bool run(uint32 threadCount)
+            {
+                if (threadCount > iCount)
+                    threadCount = iCount;
+
+                std::vector<ThreadHandle> threads;
+                for (uint32 i = 1; i < threadCount; ++i)
+                {
+#if PLATFORM == PLATFORM_WINDOWS
+                    ThreadHandle thread = CreateThread(NULL, 0, threadProc, this, 0, NULL);
+                    if (thread)
+                        threads.push_back(thread);
+#else
+                    ThreadHandle thread;
+                    if (pthread_create(&thread, NULL, threadProc, this) == 0)
+                        threads.push_back(thread);
+#endif
+                }
+
+                // calling thread is a worker too
+                work();
+
+                for (uint32 i = 0; i < threads.size(); ++i)
+                {
+#if PLATFORM == PLATFORM_WINDOWS
+                    WaitForSingleObject(threads[i], INFINITE);
+                    CloseHandle(threads[i]);
+#else
+                    pthread_join(threads[i], NULL);
+#endif
+                }
+                return !iFailed;
+            }
+
+        private:
+#if PLATFORM == PLATFORM_WINDOWS
+            typedef HANDLE ThreadHandle;
+            static DWORD WINAPI threadProc(LPVOID arg) { ((AssemblerJobQueue*)arg)->work(); return 0; }
+            void lock() { EnterCriticalSection(&iLock); }
+            void unlock() { LeaveCriticalSection(&iLock); }
+            CRITICAL_SECTION iLock;
+#else
+            typedef pthread_t ThreadHandle;
+            static void* threadProc(void* arg) { ((AssemblerJobQueue*)arg)->work(); return NULL; }
+            void lock() { pthread_mutex_lock(&iLock); }
+            void unlock() { pthread_mutex_unlock(&iLock); }
+            pthread_mutex_t iLock;
+#endif
+
+            bool nextJob(uint32 &index)
+            {
+                lock();
+                bool hasJob = !iFailed && iNext < iCount;
+                if (hasJob)
+                    index = iNext++;
+                unlock();
+                return hasJob;
+            }
+
+            void work()
+            {
+                uint32 index;
+                while (nextJob(index))
+                {
+                    if (!(iAssembler->*iJob)(index))
+                    {
+                        lock();
+                        iFailed = true;
+                        unlock();
+                    }
+                }
+            }
+
+            TileAssembler* iAssembler;
+            JobMethod iJob;
+            uint32 iNext;
+            uint32 iCount;
+            bool iFailed;
+    };
+
+    //=================================================================
+
     Vector3 ModelPosition::transform(const Vector3& pIn) const
     {
         Vector3 out = pIn * iScale;
@@ -57,6 +174,7 @@ namespace VMAP
     TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
     {
         iCurrentUniqueNameId = 0;
+        iThreadCount = 1;
         iFilterMethod = NULL;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
@@ -71,130 +189,151 @@ namespace VMAP
 
     bool TileAssembler::convertWorld2()
     {
-        std::set<std::string> spawnedModelFiles;
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        // export Map data, each map only writes its own files
+        iMapJobs.clear();
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+            iMapJobs.push_back(map_iter);
+        iMapModelFiles.assign(iMapJobs.size(), std::set<std::string>());
+
+        success = AssemblerJobQueue(this, &TileAssembler::convertMap, iMapJobs.size()).run(iThreadCount);
+
+        std::set<std::string> spawnedModelFiles;
+        for (uint32 i = 0; i < iMapModelFiles.size(); ++i)
+            spawnedModelFiles.insert(iMapModelFiles[i].begin(), iMapModelFiles[i].end());
+
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        iModelJobs.assign(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        if (!AssemblerJobQueue(this, &TileAssembler::convertModel, iModelJobs.size()).run(iThreadCount))
+            success = false;
+
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        iMapJobs.clear();
+        iMapModelFiles.clear();
+        iModelJobs.clear();
+        return success;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapJobIndex)
+    {
+        bool success = true;
+        MapData::iterator map_iter = iMapJobs[mapJobIndex];
+        std::set<std::string> &spawnedModelFiles = iMapModelFiles[mapJobIndex];
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    // TODO: remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                if (!calculateTransformedBound(entry->second))
+                    break;
             }
-
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
-            if (!modelNodeIdx.empty())
-                printf("min GUID: %u, max GUID: %u\n", modelNodeIdx.begin()->first, modelNodeIdx.rbegin()->first);
-
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE *mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                // TODO: remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            spawnedModelFiles.insert(entry->second.name);
+        }
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
-            {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
-            }
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        if (!modelNodeIdx.empty())
+            printf("min GUID: %u, max GUID: %u\n", modelNodeIdx.begin()->first, modelNodeIdx.rbegin()->first);
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
+        FILE *mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
 
-            fclose(mapfile);
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+        }
 
-            // <====
+        fclose(mapfile);
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
-            {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE *tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                // write tile spawns
-                for (uint32 s=0; s<nSpawns; ++s)
-                {
-                    if (s)
-                        ++tile;
-                    const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                }
-                fclose(tilefile);
-            }
-            // break; //test, extract only first map; TODO: remvoe this line
-        }
+        // <====
 
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = map_iter->second->TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
+            const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+            FILE *tilefile = fopen(tilefilename.str().c_str(), "wb");
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+            // write tile spawns
+            for (uint32 s=0; s<nSpawns; ++s)
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                if (s)
+                    ++tile;
+                const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
+                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
             }
+            fclose(tilefile);
         }
+        return success;
+    }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+    bool TileAssembler::convertModel(uint32 modelJobIndex)
+    {
+        const std::string &modelFile = iModelJobs[modelJobIndex];
+        printf("Converting %s\n", modelFile.c_str());
+        if (!convertRawFile(modelFile))
         {
-            delete map_iter->second;
+            printf("error converting %s\n", modelFile.c_str());
+            return false;
         }
-        return success;
+        return true;
     }
 
     bool TileAssembler::readMapSpawns()
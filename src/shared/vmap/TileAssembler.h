@@ -22,6 +22,8 @@
 #include <G3D/Vector3.h>
 #include <G3D/Matrix3.h>
 #include <map>
+#include <set>
+#include <vector>
 
 #include "ModelInstance.h"
 
@@ -70,6 +72,15 @@ namespace VMAP
             G3D::Table<std::string, unsigned int > iUniqueNameIds;
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
+            uint32 iThreadCount;
+
+            // work lists of convertWorld2, one entry per job
+            std::vector<MapData::iterator> iMapJobs;
+            std::vector<std::set<std::string> > iMapModelFiles;
+            std::vector<std::string> iModelJobs;
+
+            bool convertMap(uint32 mapJobIndex);
+            bool convertModel(uint32 modelJobIndex);
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -81,6 +92,8 @@ namespace VMAP
 
             bool convertRawFile(const std::string& pModelFilename);
             void setModelNameFilterMethod(bool (*pFilterMethod)(char *pName)) { iFilterMethod = pFilterMethod; }
+            //! maps and models are independent and converted in parallel, output does not depend on the thread count
+            void setThreadCount(uint32 pThreadCount) { iThreadCount = pThreadCount ? pThreadCount : 1; }
             std::string getDirEntryNameFromModName(unsigned int pMapId, const std::string& pModPosName);
             unsigned int getUniqueNameId(const std::string pName);
     };
@@ -26,7 +26,7 @@ namespace VMAP
 {
     //=====================================
     #define MAX_CAN_FALL_DISTANCE 10.0f
-    const char VMAP_MAGIC[] = "VMAP_3.0";
+    const char VMAP_MAGIC[] = "VMAP_3.1";                  // 3.1: LIQU chunk data padded for mapped loading
 
     class VMapDefinitions
     {
@@ -133,6 +133,22 @@ namespace VMAP
         return result;
     }
 
+    //=========================================================
+
+    void VMapManager2::preloadMapFiles(const char* pBasePath, unsigned int pMapId, int x, int y)
+    {
+        // only flags set at config load are used here, no loaded map data. Ignored map ids
+        // can be changed by config reload meanwhile, so they are left to loadMap at map thread
+        if (!isMapLoadingEnabled())
+            return;
+
+        std::string basePath = pBasePath;
+        if (basePath.length() > 0 && basePath[basePath.length()-1] != '/' && basePath[basePath.length()-1] != '\\')
+            basePath.append("/");
+
+        StaticMapTree::PreloadMapTileFiles(basePath, pMapId, x, y);
+    }
+
     //=========================================================
     // load one tile (internal use only)
 
@@ -200,6 +216,40 @@ namespace VMAP
         }
         return result;
     }
+
+    void VMapManager2::isInLineOfSight(unsigned int pMapId, LineOfSightQuery* pQueries, unsigned int pCount)
+    {
+        for (unsigned int i = 0; i < pCount; ++i)
+            pQueries[i].result = true;
+
+        if (!isLineOfSightCalcEnabled()) return;
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos1, pos2;
+        std::vector<unsigned int> index;
+        pos1.reserve(pCount);
+        pos2.reserve(pCount);
+        index.reserve(pCount);
+        for (unsigned int i = 0; i < pCount; ++i)
+        {
+            Vector3 from = convertPositionToInternalRep(pQueries[i].x1, pQueries[i].y1, pQueries[i].z1);
+            Vector3 to = convertPositionToInternalRep(pQueries[i].x2, pQueries[i].y2, pQueries[i].z2);
+            if (from == to)
+                continue;
+            pos1.push_back(from);
+            pos2.push_back(to);
+            index.push_back(i);
+        }
+        if (index.empty())
+            return;
+
+        std::vector<bool> results;
+        instanceTree->second->isInLineOfSight(&pos1[0], &pos2[0], index.size(), results);
+        for (unsigned int i = 0; i < index.size(); ++i)
+            pQueries[index[i]].result = results[i];
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -297,7 +347,7 @@ namespace VMAP
         if (model == iLoadedModelFiles.end())
         {
             WorldModel *worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            if (!worldmodel->readFile(basepath + filename + ".vmo", isModelFileMappingEnabled()))
             {
                 std::cout << "VMapManager2: could not load '" << basepath << filename << ".vmo'!\n";
                 delete worldmodel;
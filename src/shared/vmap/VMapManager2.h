@@ -83,11 +83,13 @@ namespace VMAP
             ~VMapManager2(void);
 
             int loadMap(const char* pBasePath, unsigned int pMapId, int x, int y);
+            void preloadMapFiles(const char* pBasePath, unsigned int pMapId, int x, int y);
 
             void unloadMap(unsigned int pMapId, int x, int y);
             void unloadMap(unsigned int pMapId);
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            void isInLineOfSight(unsigned int pMapId, LineOfSightQuery* pQueries, unsigned int pCount);
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -19,6 +19,20 @@
 #include "WorldModel.h"
 #include "VMapDefinitions.h"
 #include "MapTree.h"
+#include "MappedFile.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define VMAP_SSE_RAY_TEST
+#elif defined(_MSC_VER) && defined(_M_IX86)
+    // compiler can emit SSE without /arch flag, CPU is checked at startup
+    #define VMAP_SSE_RAY_TEST
+    #define VMAP_SSE_RUNTIME_CHECK
+    #include <intrin.h>
+#endif
+
+#ifdef VMAP_SSE_RAY_TEST
+    #include <xmmintrin.h>
+#endif
 
 using G3D::Vector3;
 using G3D::Ray;
@@ -31,7 +45,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, const G3D::Ray &ray, float &distance)
+    bool IntersectTriangle(const MeshTriangle &tri, const Vector3 *points, const G3D::Ray &ray, float &distance)
     {
         static const float EPS = 1e-5f;
 
@@ -99,6 +113,140 @@ namespace VMAP
             const std::vector<Vector3>::const_iterator vertices;
     };
 
+    // ===================== PackedTriangles ==================================
+
+#ifdef VMAP_SSE_RUNTIME_CHECK
+    static bool CheckSSE()
+    {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 25)) != 0;
+    }
+
+    static const bool sseSupported = CheckSSE();
+#endif
+
+    bool PackedTriangles::IsSupported()
+    {
+#if defined(VMAP_SSE_RUNTIME_CHECK)
+        return sseSupported;
+#elif defined(VMAP_SSE_RAY_TEST)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void PackedTriangles::build(const MappedArray<Vector3> &vert, const MappedArray<MeshTriangle> &tri, const BIH &tree)
+    {
+        clear();
+        if (tri.empty() || !IsSupported())
+            return;
+
+        // last leaf is loaded 4 wide, padding triangles are degenerated and never hit
+        stride = tri.size() + 3;
+        data.resize(COMPONENT_COUNT * stride, 0.0f);
+
+        for (uint32 pos = 0; pos < tri.size(); ++pos)
+        {
+            const MeshTriangle &t = tri[tree.getObject(pos)];
+            const Vector3 &v0 = vert[t.idx0];
+            const Vector3 e1 = vert[t.idx1] - v0;
+            const Vector3 e2 = vert[t.idx2] - v0;
+
+            data[V0_X * stride + pos] = v0.x;
+            data[V0_Y * stride + pos] = v0.y;
+            data[V0_Z * stride + pos] = v0.z;
+            data[E1_X * stride + pos] = e1.x;
+            data[E1_Y * stride + pos] = e1.y;
+            data[E1_Z * stride + pos] = e1.z;
+            data[E2_X * stride + pos] = e2.x;
+            data[E2_Y * stride + pos] = e2.y;
+            data[E2_Z * stride + pos] = e2.z;
+        }
+    }
+
+#ifdef VMAP_SSE_RAY_TEST
+    // same test as IntersectTriangle, for 4 triangles at once
+    bool PackedTriangles::IntersectRay(const G3D::Ray &ray, uint32 first, uint32 count, float &distance) const
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 eps = _mm_set1_ps(1e-5f);
+
+        const __m128 dx = _mm_set1_ps(ray.direction().x);
+        const __m128 dy = _mm_set1_ps(ray.direction().y);
+        const __m128 dz = _mm_set1_ps(ray.direction().z);
+        const __m128 ox = _mm_set1_ps(ray.origin().x);
+        const __m128 oy = _mm_set1_ps(ray.origin().y);
+        const __m128 oz = _mm_set1_ps(ray.origin().z);
+
+        const float *base = &data[0];
+        bool hit = false;
+
+        for (uint32 pos = first; pos < first + count; pos += 4)
+        {
+            const __m128 e1x = _mm_loadu_ps(base + E1_X * stride + pos);
+            const __m128 e1y = _mm_loadu_ps(base + E1_Y * stride + pos);
+            const __m128 e1z = _mm_loadu_ps(base + E1_Z * stride + pos);
+            const __m128 e2x = _mm_loadu_ps(base + E2_X * stride + pos);
+            const __m128 e2y = _mm_loadu_ps(base + E2_Y * stride + pos);
+            const __m128 e2z = _mm_loadu_ps(base + E2_Z * stride + pos);
+
+            // p = dir x e2, a = e1 . p
+            const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+            // lanes with ill-conditioned determinant get inf/nan values below, they are masked here
+            __m128 mask = _mm_cmpge_ps(_mm_max_ps(a, _mm_sub_ps(zero, a)), eps);
+            const __m128 f = _mm_div_ps(one, a);
+
+            const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(base + V0_X * stride + pos));
+            const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(base + V0_Y * stride + pos));
+            const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(base + V0_Z * stride + pos));
+            const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+            mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+            // q = s x e1
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+            mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+            const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+            mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, _mm_set1_ps(distance))));
+
+            // skip lanes after end of leaf, they belong to next leaf
+            int lanes = _mm_movemask_ps(mask);
+            if (first + count - pos < 4)
+                lanes &= (1 << (first + count - pos)) - 1;
+            if (!lanes)
+                continue;
+
+            float dist[4];
+            _mm_storeu_ps(dist, t);
+            for (int i = 0; i < 4; ++i)
+            {
+                if ((lanes & (1 << i)) && dist[i] < distance)
+                {
+                    distance = dist[i];
+                    hit = true;
+                }
+            }
+        }
+        return hit;
+    }
+#else
+    bool PackedTriangles::IntersectRay(const G3D::Ray &/*ray*/, uint32 /*first*/, uint32 /*count*/, float &/*distance*/) const
+    {
+        // never built without SSE, GroupModel uses IntersectTriangle then
+        return false;
+    }
+#endif
+
     // ===================== WmoLiquid ==================================
 
     WmoLiquid::WmoLiquid(uint32 width, uint32 height, const Vector3 &corner, uint32 type):
@@ -182,22 +330,25 @@ namespace VMAP
         return result;
     }
 
-    bool WmoLiquid::readFromFile(FILE *rf, WmoLiquid *&out)
+    bool WmoLiquid::readFromMemory(MemoryReader &reader, WmoLiquid *&out)
     {
         bool result = true;
         WmoLiquid *liquid = new WmoLiquid();
-        if (result && fread(&liquid->iTilesX, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iTilesY, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iCorner, sizeof(Vector3), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iType, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.read(&liquid->iTilesX, sizeof(uint32))) result = false;
+        if (result && !reader.read(&liquid->iTilesY, sizeof(uint32))) result = false;
+        if (result && !reader.read(&liquid->iCorner, sizeof(Vector3))) result = false;
+        if (result && !reader.read(&liquid->iType, sizeof(uint32))) result = false;
         uint32 size = (liquid->iTilesX + 1)*(liquid->iTilesY + 1);
-        liquid->iHeight = new float[size];
-        if (result && fread(liquid->iHeight, sizeof(float), size, rf) != size) result = false;
+        if (result) liquid->iHeight = new float[size];
+        if (result && !reader.read(liquid->iHeight, sizeof(float) * size)) result = false;
         size = liquid->iTilesX * liquid->iTilesY;
-        liquid->iFlags = new uint8[size];
-        if (result && fread(liquid->iFlags, sizeof(uint8), size, rf) != size) result = false;
+        if (result) liquid->iFlags = new uint8[size];
+        if (result && !reader.read(liquid->iFlags, sizeof(uint8) * size)) result = false;
         if (!result)
+        {
             delete liquid;
+            liquid = 0;
+        }
         out = liquid;
         return result;
     }
@@ -206,7 +357,8 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel &other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree),
+        packedTriangles(other.packedTriangles), iLiquid(0)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
@@ -214,10 +366,11 @@ namespace VMAP
 
     void GroupModel::setMeshData(std::vector<Vector3> &vert, std::vector<MeshTriangle> &tri)
     {
+        TriBoundFunc bFunc(vert);
+        meshTree.build(tri, bFunc);
         vertices.swap(vert);
         triangles.swap(tri);
-        TriBoundFunc bFunc(vertices);
-        meshTree.build(triangles, bFunc);
+        packedTriangles.build(vertices, triangles, meshTree);
     }
 
     bool GroupModel::writeToFile(FILE *wf)
@@ -237,7 +390,7 @@ namespace VMAP
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result && fwrite(&vertices[0], sizeof(Vector3), count, wf) != count) result = false;
+        if (result && fwrite(vertices.begin(), sizeof(Vector3), count, wf) != count) result = false;
 
         // write triangle mesh
         if (result && fwrite("TRIM", 1, 4, wf) != 4) result = false;
@@ -245,7 +398,7 @@ namespace VMAP
         chunkSize = sizeof(uint32)+ sizeof(MeshTriangle)*count;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
-        if (result && fwrite(&triangles[0], sizeof(MeshTriangle), count, wf) != count) result = false;
+        if (result && fwrite(triangles.begin(), sizeof(MeshTriangle), count, wf) != count) result = false;
 
         // write mesh BIH
         if (result && fwrite("MBIH", 1, 4, wf) != 4) result = false;
@@ -259,58 +412,66 @@ namespace VMAP
             if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
             return result;
         }
+        // pad liquid data to keep arrays of next group 4 byte aligned for mapped loading,
+        // readers skip chunkSize - GetFileSize() bytes after liquid (GetFileSize() does not count iType)
         chunkSize = iLiquid->GetFileSize();
+        uint32 padding = (4 - (ftell(wf) + sizeof(uint32) + chunkSize + sizeof(uint32)) % 4) % 4;
+        chunkSize += padding;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result) result = iLiquid->writeToFile(wf);
+        static const uint8 zeros[4] = { 0, 0, 0, 0 };
+        if (result && padding && fwrite(zeros, 1, padding, wf) != padding) result = false;
 
         return result;
     }
 
-    bool GroupModel::readFromFile(FILE *rf)
+    bool GroupModel::readFromMemory(MemoryReader &reader)
     {
-        char chunk[8];
         bool result = true;
-        uint32 chunkSize, count;
+        uint32 chunkSize, count = 0;
         triangles.clear();
         vertices.clear();
+        packedTriangles.clear();
         delete iLiquid;
         iLiquid = 0;
 
-        if (result && fread(&iBound, sizeof(G3D::AABox), 1, rf) != 1) result = false;
-        if (result && fread(&iMogpFlags, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&iGroupWMOID, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.read(&iBound, sizeof(G3D::AABox))) result = false;
+        if (result && !reader.read(&iMogpFlags, sizeof(uint32))) result = false;
+        if (result && !reader.read(&iGroupWMOID, sizeof(uint32))) result = false;
 
         // read vertices
-        if (result && !readChunk(rf, chunk, "VERT", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.readChunk("VERT", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&count, sizeof(uint32))) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result) vertices.resize(count);
-        if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        if (result && !reader.readArray(vertices, count)) result = false;
 
         // read triangle mesh
-        if (result && !readChunk(rf, chunk, "TRIM", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result) triangles.resize(count);
-        if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+        if (result && !reader.readChunk("TRIM", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&count, sizeof(uint32))) result = false;
+        if (result && !reader.readArray(triangles, count)) result = false;
 
         // read mesh BIH
-        if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
-        if (result) result = meshTree.readFromFile(rf);
+        if (result && !reader.readChunk("MBIH", 4)) result = false;
+        if (result) result = meshTree.readFromMemory(reader);
+        if (result) packedTriangles.build(vertices, triangles, meshTree);
 
-        // write liquid data
-        if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
+        // read liquid data
+        if (result && !reader.readChunk("LIQU", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
         if (result && chunkSize > 0)
-            result = WmoLiquid::readFromFile(rf, iLiquid);
+            result = WmoLiquid::readFromMemory(reader, iLiquid);
+        // alignment padding of newer files
+        if (result && iLiquid && chunkSize > iLiquid->GetFileSize())
+            result = reader.skip(chunkSize - iLiquid->GetFileSize());
         return result;
     }
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
+        GModelRayCallback(const MappedArray<MeshTriangle> &tris, const MappedArray<Vector3> &vert):
             vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool pStopAtFirstHit)
         {
@@ -318,8 +479,21 @@ namespace VMAP
             if (result)  hit=true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const Vector3 *vertices;
+        const MeshTriangle *triangles;
+        bool hit;
+    };
+
+    struct GModelLeafRayCallback
+    {
+        GModelLeafRayCallback(const PackedTriangles &tris): triangles(tris), hit(false) {}
+        bool operator()(const G3D::Ray& ray, uint32 firstPos, uint32 count, float& distance, bool /*pStopAtFirstHit*/)
+        {
+            if (triangles.IntersectRay(ray, firstPos, count, distance))
+                hit = true;
+            return hit;
+        }
+        const PackedTriangles &triangles;
         bool hit;
     };
 
@@ -327,6 +501,12 @@ namespace VMAP
     {
         if (!triangles.size())
             return false;
+        if (!packedTriangles.empty())
+        {
+            GModelLeafRayCallback callback(packedTriangles);
+            meshTree.intersectRayLeaves(ray, callback, distance, stopAtFirstHit);
+            return callback.hit;
+        }
         GModelRayCallback callback(triangles, vertices);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
@@ -498,38 +678,83 @@ namespace VMAP
         return result;
     }
 
-    bool WorldModel::readFile(const std::string &filename)
+    WorldModel::~WorldModel()
     {
-        FILE *rf = fopen(filename.c_str(), "rb");
-        if (!rf)
-            return false;
+        delete iMappedFile;
+    }
 
+    bool WorldModel::readFile(const std::string &filename, bool mapFile)
+    {
+        MappedFile *mapped = 0;
+        std::vector<char> buffer;
+        const char *data = 0;
+        uint32 size = 0;
+
+        if (mapFile)
+        {
+            mapped = new MappedFile();
+            if (mapped->open(filename))
+            {
+                data = mapped->data();
+                size = mapped->size();
+            }
+            else
+            {
+                // empty or not mappable file, read it as without mapping
+                delete mapped;
+                mapped = 0;
+            }
+        }
+
+        if (!data)
+        {
+            FILE *rf = fopen(filename.c_str(), "rb");
+            if (!rf)
+                return false;
+            fseek(rf, 0, SEEK_END);
+            long length = ftell(rf);
+            fseek(rf, 0, SEEK_SET);
+            if (length > 0)
+            {
+                buffer.resize(length);
+                if (fread(&buffer[0], 1, length, rf) == size_t(length))
+                {
+                    data = &buffer[0];
+                    size = length;
+                }
+            }
+            fclose(rf);
+            if (!data)
+                return false;
+        }
+
+        MemoryReader reader(data, size, mapped != 0);
         bool result = true;
         uint32 chunkSize, count;
-        char chunk[8];                          // Ignore the added magic header
-        if (!readChunk(rf, chunk, VMAP_MAGIC, 8)) result = false;
+        if (!reader.readChunk(VMAP_MAGIC, 8)) result = false;
 
-        if (result && !readChunk(rf, chunk, "WMOD", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&RootWMOID, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.readChunk("WMOD", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&RootWMOID, sizeof(uint32))) result = false;
 
         // read group models
-        if (result && readChunk(rf, chunk, "GMOD", 4))
+        if (result && reader.readChunk("GMOD", 4))
         {
-            //if (fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-
-            if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
+            if (result && !reader.read(&count, sizeof(uint32))) result = false;
             if (result) groupModels.resize(count);
-            //if (result && fread(&groupModels[0], sizeof(GroupModel), count, rf) != count) result = false;
             for (uint32 i=0; i<count && result; ++i)
-                result = groupModels[i].readFromFile(rf);
+                result = groupModels[i].readFromMemory(reader);
 
             // read group BIH
-            if (result && !readChunk(rf, chunk, "GBIH", 4)) result = false;
-            if (result) result = groupTree.readFromFile(rf);
+            if (result && !reader.readChunk("GBIH", 4)) result = false;
+            if (result) result = groupTree.readFromMemory(reader);
         }
 
-        fclose(rf);
+        if (mapped)
+        {
+            delete iMappedFile;
+            iMappedFile = mapped;
+        }
         return result;
     }
 }
@@ -30,6 +30,7 @@
 namespace VMAP
 {
     class TreeNode;
+    class MappedFile;
     struct AreaInfo;
     struct LocationInfo;
 
@@ -44,6 +45,24 @@ namespace VMAP
             uint32 idx2;
     };
 
+    /*! triangles of a mesh in BIH leaf order as separate coordinate arrays with
+        precomputed edges, to test a leaf with 4 triangles per SSE instruction */
+    class PackedTriangles
+    {
+        public:
+            PackedTriangles(): stride(0) {}
+            void build(const MappedArray<Vector3> &vert, const MappedArray<MeshTriangle> &tri, const BIH &tree);
+            void clear() { data.clear(); stride = 0; }
+            bool empty() const { return data.empty(); }
+            //! closest hit of triangles at leaf positions [first, first+count), distance is updated on hit
+            bool IntersectRay(const G3D::Ray &ray, uint32 first, uint32 count, float &distance) const;
+            static bool IsSupported();
+        private:
+            enum Component { V0_X, V0_Y, V0_Z, E1_X, E1_Y, E1_Z, E2_X, E2_Y, E2_Z, COMPONENT_COUNT };
+            uint32 stride;              //!< triangle count + padding of last load
+            std::vector<float> data;    //!< COMPONENT_COUNT arrays of stride values
+    };
+
     class WmoLiquid
     {
         public:
@@ -57,7 +76,7 @@ namespace VMAP
             uint8 *GetFlagsStorage() { return iFlags; }
             uint32 GetFileSize();
             bool writeToFile(FILE *wf);
-            static bool readFromFile(FILE *rf, WmoLiquid *&liquid);
+            static bool readFromMemory(MemoryReader &reader, WmoLiquid *&liquid);
         private:
             WmoLiquid(): iHeight(0), iFlags(0) {};
             uint32 iTilesX;  //!< number of tiles in x direction, each
@@ -86,7 +105,7 @@ namespace VMAP
             bool GetLiquidLevel(const Vector3 &pos, float &liqHeight) const;
             uint32 GetLiquidType() const;
             bool writeToFile(FILE *wf);
-            bool readFromFile(FILE *rf);
+            bool readFromMemory(MemoryReader &reader);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -94,21 +113,24 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
-            std::vector<Vector3> vertices;
-            std::vector<MeshTriangle> triangles;
+            MappedArray<Vector3> vertices;
+            MappedArray<MeshTriangle> triangles;
             BIH meshTree;
+            PackedTriangles packedTriangles;
             WmoLiquid *iLiquid;
 
 #ifdef MMAP_GENERATOR
         public:
-            void getMeshData(std::vector<Vector3> &vertices, std::vector<MeshTriangle> &triangles);
+            std::vector<Vector3> getVertices() const;
+            std::vector<MeshTriangle> getTriangles() const;
 #endif
     };
     /*! Holds a model (converted M2 or WMO) in its original coordinate space */
     class WorldModel
     {
         public:
-            WorldModel(): RootWMOID(0) {}
+            WorldModel(): RootWMOID(0), iMappedFile(0) {}
+            ~WorldModel();
 
             //! pass group models to WorldModel and create BIH. Passed vector is swapped with old geometry!
             void setGroupModels(std::vector<GroupModel> &models);
@@ -117,15 +139,20 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, LocationInfo &info) const;
             bool writeFile(const std::string &filename);
-            bool readFile(const std::string &filename);
+            //! with mapFile, file stays mapped and mesh data is used in place
+            bool readFile(const std::string &filename, bool mapFile = false);
         protected:
             uint32 RootWMOID;
             std::vector<GroupModel> groupModels;
             BIH groupTree;
+            MappedFile *iMappedFile;            //!< mesh data of group models may point into it
+        private:
+            WorldModel(const WorldModel &);
+            WorldModel& operator=(const WorldModel &);
 
 #ifdef MMAP_GENERATOR
         public:
-            void getGroupModels(std::vector<GroupModel> &groupModels);
+            const std::vector<GroupModel>& getGroupModels() const;
 #endif
     };
 } // namespace VMAP
@@ -274,6 +274,9 @@ void ChatHandler::HandleCharacterDeletedRestoreHelper(DeletedInfo const& delInfo
 
     CharacterDatabase.PExecute("UPDATE characters SET name='%s', account='%u', deleteDate=NULL, deleteInfos_Name=NULL, deleteInfos_Account=NULL WHERE deleteDate IS NOT NULL AND guid = %u",
         delInfo.name.c_str(), delInfo.accountId, delInfo.lowguid);
+
+    if (PlayerIdentity const* identity = sObjectMgr.GetPlayerIdentity(delInfo.lowguid))
+        sObjectMgr.SetPlayerIdentity(delInfo.lowguid, delInfo.name, delInfo.accountId, identity->race, identity->class_, identity->gender, identity->level);
 }
 
 /**
@@ -406,6 +406,9 @@ int Master::Run()
     // fixes a memory leak related to detaching threads from the module
     UnloadScriptingModule();
 
+    ///- Write queued log output before leaving
+    sLog.HaltWriterThread();
+
     ///- Exit the process with specified return value
     return World::GetExitCode();
 }
@@ -23,6 +23,7 @@
 #include "Timer.h"
 #include "MapManager.h"
 #include "BattleGroundMgr.h"
+#include "ObjectMgr.h"
 
 #include "Database/DatabaseEnv.h"
 
@@ -84,6 +85,8 @@ void WorldRunnable::run()
 
     MapManager::Instance().UnloadAll();                     // unload all grids (including locked in memory)
 
+    sObjectMgr.SaveRespawnTimes();                          // write respawn times saved at grid unload
+
     ///- End the database thread
     WorldDatabase.ThreadEnd();                                  // free mySQL thread resources
 }